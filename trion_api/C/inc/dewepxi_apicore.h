@@ -105,6 +105,83 @@ typedef int (RT_IMPORT *PDEWEWRITEDMAUART)(int board_no, PBOARD_UART_FRAME pUart
 typedef const char* (RT_IMPORT *PDEWEERRORCONSTANTTOSTRING) ( int );
 
 
+// Function table, loaded by DeWePxiLoadTable (dewepxi_loadcore.h)
+#if defined(_MSC_VER)
+#  define DEWEPXI_CACHE_ALIGNED __declspec(align(64))
+#else
+#  define DEWEPXI_CACHE_ALIGNED __attribute__((aligned(64)))
+#endif
+
+// Optional entry points, set in DEWEPXI_FUNCTION_TABLE.capabilities if resolved
+#define DEWEPXI_CAP_GETPARAMXML_STRLEN      0x00000001u
+#define DEWEPXI_CAP_FREEFRAMESCAN           0x00000002u
+#define DEWEPXI_CAP_FREEDMAUARTRAWFRAME     0x00000004u
+#define DEWEPXI_CAP_GETPARAMSTRUCTEX_STR    0x00000008u
+#define DEWEPXI_CAP_READCANEX               0x00000010u
+#define DEWEPXI_CAP_READCANRAWFRAMEEX       0x00000020u
+#define DEWEPXI_CAP_WRITECANEX              0x00000040u
+#define DEWEPXI_CAP_READCANNG               0x00000080u
+
+// Functions used in acquisition loops come first to share one cache line.
+// Optional entry points are NULL if not provided by the library.
+typedef struct DEWEPXI_CACHE_ALIGNED tagDEWEPXI_FUNCTION_TABLE {
+    // acquisition loop
+    PDEWEGETPARAM_I32               DeWeGetParam_i32;
+    PDEWESETPARAM_I32               DeWeSetParam_i32;
+    PDEWEGETPARAM_I64               DeWeGetParam_i64;
+    PDEWESETPARAM_I64               DeWeSetParam_i64;
+    PDEWEREADCANNG                  DeWeReadCANNg;
+    PDEWEREADCANRAWFRAMEEX          DeWeReadCANRawFrameEx;
+    PDEWEFREEFRAMESCAN              DeWeFreeFramesCAN;
+    PDEWEFREEDMAUARTRAWFRAME        DeWeFreeDmaUartRawFrame;
+
+    // Driver Init
+    PDEWEDRIVERINIT                 DeWeDriverInit;
+    PDEWEDRIVERDEINIT               DeWeDriverDeInit;
+
+    // string based functions
+    PDEWESETPARAMSTRUCT_STR         DeWeSetParamStruct_str;
+    PDEWEGETPARAMSTRUCT_STR         DeWeGetParamStruct_str;
+    PDEWEGETPARAMSTRUCT_STRLEN      DeWeGetParamStruct_strLEN;
+    PDEWEGETPARAMSTRUCTEX_STR       DeWeGetParamStructEx_str;
+    PDEWESETPARAMXML_STR            DeWeSetParamXML_str;
+    PDEWEGETPARAMXML_STR            DeWeGetParamXML_str;
+    PDEWEGETPARAMXML_STRLEN         DeWeGetParamXML_strLEN;
+
+    // CAN functions
+    PDEWEOPENCAN                    DeWeOpenCAN;
+    PDEWECLOSECAN                   DeWeCloseCAN;
+    PDEWEGETCHANNELPROPCAN          DeWeGetChannelPropCAN;
+    PDEWESETCHANNELPROPCAN          DeWeSetChannelPropCAN;
+    PDEWESTARTCAN                   DeWeStartCAN;
+    PDEWESTOPCAN                    DeWeStopCAN;
+    PDEWEERRORCNTCAN                DeWeErrorCntCAN;
+    PDEWEREADCAN                    DeWeReadCAN;
+    PDEWEREADCANRAWFRAME            DeWeReadCANRawFrame;
+    PDEWEWRITECAN                   DeWeWriteCAN;
+    PDEWEREADCANEX                  DeWeReadCANEx;
+    PDEWEWRITECANEX                 DeWeWriteCANEx;
+
+    // Asynchronous channel(UART) functions
+    PDEWEOPENDMAUART                DeWeOpenDmaUart;
+    PDEWECLOSEDMAUART               DeWeCloseDmaUart;
+    PDEWEGETCHANNELPROPDMAUART      DeWeGetChannelPropDmaUart;
+    PDEWESETCHANNELPROPDMAUART      DeWeSetChannelPropDmaUart;
+    PDEWESTARTDMAUART               DeWeStartDmaUart;
+    PDEWESTOPDMAUART                DeWeStopDmaUart;
+    PDEWEREADDMAUART                DeWeReadDmaUart;
+    PDEWEREADDMAUARTRAWFRAME        DeWeReadDmaUartRawFrame;
+    PDEWEWRITEDMAUART               DeWeWriteDmaUart;
+
+    // Obtain readable ErrorMessage from ErrorCode
+    PDEWEERRORCONSTANTTOSTRING      DeWeErrorConstantToString;
+
+    void*                           hLib;
+    int                             revision;       // same as DeWePxiLoadByName
+    unsigned int                    capabilities;   // DEWEPXI_CAP_*
+} DEWEPXI_FUNCTION_TABLE, *PDEWEPXI_FUNCTION_TABLE;
+
+
 //###############################################################################################################################################
 
 #ifdef __cplusplus
@@ -19,6 +19,7 @@
 #include "dewepxi_apiutil.h"
 #endif
 #include <stdio.h>
+#include <string.h>
 #if !defined(WIN32) && !defined(__APPLE__) && defined(__linux__)
 #include <linux/limits.h>
 #include <libgen.h>
@@ -52,6 +53,8 @@ namespace trion_c_api {
 #  endif
 #endif
 
+#ifndef DEWEPXI_LOAD_TABLE_ONLY
+
 // Load DLL
 int DeWePxiLoad(void);
 
@@ -61,6 +64,49 @@ void DeWePxiUnload(void);
 // Load DLL by name
 int DeWePxiLoadByName(const char* name);
 
+#endif // DEWEPXI_LOAD_TABLE_ONLY
+
+
+#ifndef STATIC_DLL
+
+//*************************************************************************************
+// Function table interface
+//
+// Alternative to the global function pointers: every table holds its own
+// library handle, so several APIs (eg TRION and TRIONET) can be loaded
+// side by side. Optional entry points are probed one by one and reported
+// in the capability bitmap, so callers can choose a read path once at startup:
+//
+//   DEWEPXI_FUNCTION_TABLE api;
+//   if (DeWePxiLoadTable(DEWE_TRION_DLL_NAME, &api) > 0) {
+//       if (api.capabilities & DEWEPXI_CAP_READCANNG) ...
+//   }
+//
+// DEWEPXI_FUNCTION_TABLE and the DEWEPXI_CAP_* bits are declared in
+// dewepxi_apicore.h, this header only implements the loader.
+//
+// Libraries define DEWEPXI_LOAD_TABLE_ONLY before including this header:
+// only the table functions are defined, with internal linkage, so they do
+// not clash with the DeWePxiLoad symbols of the application.
+//*************************************************************************************
+
+#ifdef DEWEPXI_LOAD_TABLE_ONLY
+#  define DEWEPXI_TABLE_API static
+#else
+#  define DEWEPXI_TABLE_API
+#endif
+
+// Load DLL by name into table, returns the revision or 0 on failure
+DEWEPXI_TABLE_API int DeWePxiLoadTable(const char* name, PDEWEPXI_FUNCTION_TABLE table);
+
+// Unload DLL of table, calls DeWeDriverDeInit
+DEWEPXI_TABLE_API void DeWePxiUnloadTable(PDEWEPXI_FUNCTION_TABLE table);
+
+#elif defined(DEWEPXI_LOAD_TABLE_ONLY)
+#  error "DEWEPXI_LOAD_TABLE_ONLY needs dynamic loading, STATIC_DLL is defined"
+
+#endif // STATIC_DLL
+
 
 #ifdef __cplusplus
 #  ifdef DEWE_PXI_NS
@@ -80,6 +126,8 @@ int DeWePxiLoadByName(const char* name);
 #  include <dlfcn.h>
 #endif //UNIX
 
+#ifndef DEWEPXI_LOAD_TABLE_ONLY
+
 static int     LoadedRevision = 0;
 
 #ifdef WIN32
@@ -121,6 +169,8 @@ void    DewePxiUnloadTestInterface() {}
 
 #endif
 
+#endif // DEWEPXI_LOAD_TABLE_ONLY
+
 
 
 
@@ -128,7 +178,7 @@ void    DewePxiUnloadTestInterface() {}
 //*************************************************************************************
 // Main Load / Unload Interface
 //*************************************************************************************
-#ifdef WIN32
+#if defined(WIN32) && !defined(DEWEPXI_LOAD_TABLE_ONLY)
 static void* loadFunction(
              const char*        pcName,
              BOOLEAN*           bTotalOK
@@ -234,6 +284,8 @@ namespace trion_c_api {
 #  endif
 #endif
 
+#ifndef DEWEPXI_LOAD_TABLE_ONLY
+
 #ifdef __DEWE_PXI_LOAD
 int DeWePxiLoad(void)
 {
@@ -241,7 +293,11 @@ int DeWePxiLoad(void)
 }
 #endif
 
+#endif // DEWEPXI_LOAD_TABLE_ONLY
+
 #ifndef STATIC_DLL
+
+#ifndef DEWEPXI_LOAD_TABLE_ONLY
 int DeWePxiLoadByName(const char* name)
 {
     BOOLEAN        bTotResult = TRUE;
@@ -452,6 +508,191 @@ void DeWePxiUnload(void)
 
 }
 
+#endif // DEWEPXI_LOAD_TABLE_ONLY
+
+
+
+//######################################################################################################################################################
+// Function table
+//######################################################################################################################################################
+static void* openTableLibrary(const char* name)
+{
+    void* lib = NULL;
+#ifdef WIN32
+    lib = (void*)LoadLibraryA(name);
+#else
+    lib = dlopen(name, DW_DLOPEN_FLAGS);
+#  if !defined(__APPLE__) && defined(__linux__)
+    if (!lib)
+    {
+        char executable_path[PATH_MAX];
+        ssize_t count = readlink("/proc/self/exe", executable_path, PATH_MAX - 1);
+        if (count != -1)
+        {
+            const char *search_path;
+            char real_plugin_filename[PATH_MAX];
+            executable_path[count] = 0;
+            search_path = dirname(executable_path);
+            snprintf(real_plugin_filename, PATH_MAX, "%s/%s", search_path, name);
+            lib = dlopen(real_plugin_filename, DW_DLOPEN_FLAGS);
+        }
+    }
+#  endif
+    if (!lib)
+    {
+        fprintf(stderr, "%s\n", dlerror());
+    }
+#endif
+    return lib;
+}
+
+static void* loadTableFunction(void* lib, const char* name)
+{
+#ifdef WIN32
+    return (void*)GetProcAddress((HINSTANCE)lib, name);
+#else
+    return dlsym(lib, name);
+#endif
+}
+
+static void closeTableLibrary(void* lib)
+{
+#ifdef WIN32
+    FreeLibrary((HINSTANCE)lib);
+#else
+    dlclose(lib);
+#endif
+}
+
+// Mandatory entry point: clears bTotResult if missing
+#define LOADTABLEFUNCTION(table, type, name)                            \
+    table->name = (type)loadTableFunction(table->hLib, #name);          \
+    if (NULL == table->name) {                                          \
+        bTotResult = FALSE;                                             \
+    }
+
+// Optional entry point: sets the capability bit if present
+#define LOADTABLECAPABILITY(table, type, name, cap)                     \
+    table->name = (type)loadTableFunction(table->hLib, #name);          \
+    if (NULL != table->name) {                                          \
+        table->capabilities |= (cap);                                   \
+    }
+
+DEWEPXI_TABLE_API int DeWePxiLoadTable(const char* name, PDEWEPXI_FUNCTION_TABLE table)
+{
+    // Capabilities added by revision 2 .. 6, see DeWePxiLoadByName
+    static const unsigned int revision_caps[] = {
+        DEWEPXI_CAP_GETPARAMXML_STRLEN,
+        DEWEPXI_CAP_FREEFRAMESCAN,
+        DEWEPXI_CAP_FREEDMAUARTRAWFRAME,
+        DEWEPXI_CAP_GETPARAMSTRUCTEX_STR,
+        DEWEPXI_CAP_READCANEX | DEWEPXI_CAP_READCANRAWFRAMEEX | DEWEPXI_CAP_WRITECANEX | DEWEPXI_CAP_READCANNG,
+    };
+    BOOLEAN        bTotResult = TRUE;
+    size_t         n;
+
+    if (NULL == table || NULL == name) {
+        return 0;
+    }
+    memset(table, 0, sizeof(*table));
+
+    table->hLib = openTableLibrary(name);
+    if (!table->hLib) {
+        return 0;
+    }
+
+    // Driver Init
+    LOADTABLEFUNCTION( table, PDEWEDRIVERINIT, DeWeDriverInit );
+    LOADTABLEFUNCTION( table, PDEWEDRIVERDEINIT, DeWeDriverDeInit );
+
+    // _i32 functions
+    LOADTABLEFUNCTION( table, PDEWEGETPARAM_I32, DeWeGetParam_i32 );
+    LOADTABLEFUNCTION( table, PDEWESETPARAM_I32, DeWeSetParam_i32 );
+
+    // _i64 functions
+    LOADTABLEFUNCTION( table, PDEWEGETPARAM_I64, DeWeGetParam_i64 );
+    LOADTABLEFUNCTION( table, PDEWESETPARAM_I64, DeWeSetParam_i64 );
+
+    // string based functions
+    LOADTABLEFUNCTION( table, PDEWESETPARAMSTRUCT_STR, DeWeSetParamStruct_str );
+    LOADTABLEFUNCTION( table, PDEWEGETPARAMSTRUCT_STR, DeWeGetParamStruct_str );
+    LOADTABLEFUNCTION( table, PDEWEGETPARAMSTRUCT_STRLEN, DeWeGetParamStruct_strLEN );
+    LOADTABLEFUNCTION( table, PDEWESETPARAMXML_STR, DeWeSetParamXML_str );
+    LOADTABLEFUNCTION( table, PDEWEGETPARAMXML_STR, DeWeGetParamXML_str );
+
+    // CAN functions
+    LOADTABLEFUNCTION( table, PDEWEOPENCAN, DeWeOpenCAN );
+    LOADTABLEFUNCTION( table, PDEWECLOSECAN, DeWeCloseCAN );
+    LOADTABLEFUNCTION( table, PDEWEGETCHANNELPROPCAN, DeWeGetChannelPropCAN );
+    LOADTABLEFUNCTION( table, PDEWESETCHANNELPROPCAN, DeWeSetChannelPropCAN );
+    LOADTABLEFUNCTION( table, PDEWESTARTCAN, DeWeStartCAN );
+    LOADTABLEFUNCTION( table, PDEWESTOPCAN, DeWeStopCAN );
+    LOADTABLEFUNCTION( table, PDEWEREADCAN, DeWeReadCAN );
+    LOADTABLEFUNCTION( table, PDEWEREADCANRAWFRAME, DeWeReadCANRawFrame );
+    LOADTABLEFUNCTION( table, PDEWEWRITECAN, DeWeWriteCAN );
+    LOADTABLEFUNCTION( table, PDEWEERRORCNTCAN, DeWeErrorCntCAN );
+
+    // Asynchronous channel(UART) functions
+    LOADTABLEFUNCTION( table, PDEWEOPENDMAUART, DeWeOpenDmaUart );
+    LOADTABLEFUNCTION( table, PDEWECLOSEDMAUART, DeWeCloseDmaUart );
+    LOADTABLEFUNCTION( table, PDEWEGETCHANNELPROPDMAUART, DeWeGetChannelPropDmaUart );
+    LOADTABLEFUNCTION( table, PDEWESETCHANNELPROPDMAUART, DeWeSetChannelPropDmaUart );
+    LOADTABLEFUNCTION( table, PDEWESTARTDMAUART, DeWeStartDmaUart );
+    LOADTABLEFUNCTION( table, PDEWESTOPDMAUART, DeWeStopDmaUart );
+    LOADTABLEFUNCTION( table, PDEWEREADDMAUART, DeWeReadDmaUart );
+    LOADTABLEFUNCTION( table, PDEWEREADDMAUARTRAWFRAME, DeWeReadDmaUartRawFrame );
+    LOADTABLEFUNCTION( table, PDEWEWRITEDMAUART, DeWeWriteDmaUart );
+
+    // Obtain readable ErrorMessage from ErrorCode
+    LOADTABLEFUNCTION( table, PDEWEERRORCONSTANTTOSTRING, DeWeErrorConstantToString );
+
+    if (!bTotResult)  //no valid dll found
+    {
+        closeTableLibrary(table->hLib);
+        memset(table, 0, sizeof(*table));
+        return 0;
+    }
+
+    // optional functions, each probed on its own
+    LOADTABLECAPABILITY( table, PDEWEGETPARAMXML_STRLEN, DeWeGetParamXML_strLEN, DEWEPXI_CAP_GETPARAMXML_STRLEN );
+    LOADTABLECAPABILITY( table, PDEWEFREEFRAMESCAN, DeWeFreeFramesCAN, DEWEPXI_CAP_FREEFRAMESCAN );
+    LOADTABLECAPABILITY( table, PDEWEFREEDMAUARTRAWFRAME, DeWeFreeDmaUartRawFrame, DEWEPXI_CAP_FREEDMAUARTRAWFRAME );
+    LOADTABLECAPABILITY( table, PDEWEGETPARAMSTRUCTEX_STR, DeWeGetParamStructEx_str, DEWEPXI_CAP_GETPARAMSTRUCTEX_STR );
+    LOADTABLECAPABILITY( table, PDEWEREADCANEX, DeWeReadCANEx, DEWEPXI_CAP_READCANEX );
+    LOADTABLECAPABILITY( table, PDEWEREADCANRAWFRAMEEX, DeWeReadCANRawFrameEx, DEWEPXI_CAP_READCANRAWFRAMEEX );
+    LOADTABLECAPABILITY( table, PDEWEWRITECANEX, DeWeWriteCANEx, DEWEPXI_CAP_WRITECANEX );
+    LOADTABLECAPABILITY( table, PDEWEREADCANNG, DeWeReadCANNg, DEWEPXI_CAP_READCANNG );
+
+    // revision: highest level with all capabilities of the lower levels
+    table->revision = 1;
+    for (n = 0; n < sizeof(revision_caps) / sizeof(revision_caps[0]); ++n)
+    {
+        if ((table->capabilities & revision_caps[n]) != revision_caps[n]) {
+            break;
+        }
+        ++table->revision;
+    }
+
+    return table->revision;
+}
+
+#undef LOADTABLEFUNCTION
+#undef LOADTABLECAPABILITY
+
+DEWEPXI_TABLE_API void DeWePxiUnloadTable(PDEWEPXI_FUNCTION_TABLE table)
+{
+    if (NULL == table) {
+        return;
+    }
+    if (table->hLib) {
+        if (table->DeWeDriverDeInit != 0) {
+            table->DeWeDriverDeInit();
+        }
+        closeTableLibrary(table->hLib);
+    }
+    memset(table, 0, sizeof(*table));
+}
+
 #else // STATIC_DLL
 
 int DeWePxiLoadByName(const char* name)
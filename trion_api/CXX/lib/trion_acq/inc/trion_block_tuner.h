@@ -0,0 +1,136 @@
+// Copyright (c) DEWETRON GmbH 2026
+#pragma once
+
+#include "dewepxi_types.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace trion
+{
+    /**
+     * Histogram with quarter octave buckets from 1us to about 16s.
+     * add() does not allocate.
+     */
+    class LatencyHistogram
+    {
+    public:
+        enum
+        {
+            BUCKETS_PER_OCTAVE = 4,
+            BUCKET_COUNT = 24 * BUCKETS_PER_OCTAVE,
+        };
+
+        LatencyHistogram();
+
+        void add(double seconds);
+        void reset();
+
+        uint64_t getCount() const;
+        double getMax() const;
+
+        /**
+         * @param q 0..1, eg 0.99
+         * @return upper bound of the bucket containing the quantile in seconds, 0 if empty
+         */
+        double getQuantile(double q) const;
+
+    private:
+        uint64_t m_buckets[BUCKET_COUNT];
+        uint64_t m_count;
+        double m_max;
+    };
+
+    struct BlockRequirements
+    {
+        uint32_t scan_size;         //!< bytes, CMD_BUFFER_ONE_SCAN_SIZE
+        double sample_rate;         //!< Hz
+        double latency;             //!< end to end latency target in seconds
+        uint64_t memory_budget;     //!< bytes for the circular buffer of this board
+        double buffer_time;         //!< seconds the buffer should bridge a stalled consumer
+
+        BlockRequirements()
+            : scan_size(0)
+            , sample_rate(0)
+            , latency(0.1)
+            , memory_budget(64u << 20)
+            , buffer_time(5.0)
+        {
+        }
+    };
+
+    struct BlockTuning
+    {
+        sint32 block_size;          //!< scans, CMD_BUFFER_BLOCK_SIZE
+        sint32 block_count;         //!< CMD_BUFFER_BLOCK_COUNT
+        bool latency_met;           //!< false if the block period had to exceed the target
+        bool buffer_time_met;       //!< false if the memory budget limited the block count
+
+        double getBlockTime(double sample_rate) const
+        {
+            return sample_rate > 0 ? block_size / sample_rate : 0;
+        }
+    };
+
+    /**
+     * Picks CMD_BUFFER_BLOCK_SIZE and CMD_BUFFER_BLOCK_COUNT of one board.
+     *
+     * A sample waits up to one block period before its block is complete,
+     * so the block period starts at half the latency target, as
+     * datalosthandling.c does with its poll interval. The count covers
+     * buffer_time within the memory budget.
+     *
+     * Between runs, adapt() uses the loop times recorded with recordLoop():
+     * the time from a block becoming available until it is freed. The
+     * block period is set to the latency target minus the 99th percentile
+     * loop time, but never below twice that loop time, so the loop keeps
+     * up with the board. If both cannot be met, data integrity wins over
+     * latency.
+     */
+    class BlockTuner
+    {
+    public:
+        enum
+        {
+            MIN_BLOCK_COUNT = 4,
+        };
+
+        static BlockTuning compute(const BlockRequirements& req);
+
+        /**
+         * Distribute a total memory budget over several boards in
+         * proportion to their data rate, then compute each board.
+         * The memory_budget of the requirements is ignored.
+         */
+        static std::vector<BlockTuning> compute(const std::vector<BlockRequirements>& reqs, uint64_t total_budget);
+
+        explicit BlockTuner(const BlockRequirements& req);
+
+        const BlockRequirements& getRequirements() const;
+        const BlockTuning& getTuning() const;
+
+        /**
+         * Set CMD_BUFFER_BLOCK_SIZE and CMD_BUFFER_BLOCK_COUNT,
+         * before CMD_UPDATE_PARAM_ALL.
+         */
+        int apply(int board_no) const;
+
+        void recordLoop(double seconds);
+        const LatencyHistogram& getHistogram() const;
+
+        /**
+         * Derive the tuning of the next run from the recorded loop times
+         * and clear the histogram. Without samples the tuning is kept.
+         */
+        const BlockTuning& adapt();
+
+    private:
+        static BlockTuning fit(const BlockRequirements& req, double block_time, bool latency_met);
+
+    private:
+        BlockRequirements m_req;
+        BlockTuning m_tuning;
+        LatencyHistogram m_histogram;
+    };
+
+} // trion
@@ -0,0 +1,108 @@
+// Copyright (c) DEWETRON GmbH 2026
+#pragma once
+
+#include "dewepxi_types.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace trion
+{
+    /**
+     * Aligns the decoded channel-major streams of several boards onto
+     * one common sample index.
+     *
+     * Each group of channels has a delay in samples: a sample taken at
+     * time t appears at index t + delay of the group, eg the
+     * CMD_BOARD_ADC_DELAY of the board for its analog channels. Digital
+     * and counter channels of a board are added as a separate group with
+     * delay 0.
+     *
+     * Without FIR taps the integer part of the delay is skipped. With
+     * taps, a windowed sinc FIR additionally shifts each group by the
+     * fractional part of its delay, for sub-sample group delay
+     * differences. The FIR adds getLatency() samples to all groups alike,
+     * so the groups stay aligned.
+     *
+     * @code
+     * trion::BoardAligner aligner;
+     * for (int board : boards)
+     * {
+     *     sint32 delay = 0;
+     *     trion::BoardAligner::readAdcDelay(board, delay);
+     *     aligner.addGroup(channels[board], delay);
+     * }
+     * ...
+     * aligner.push(group, channel_ptrs, samples);
+     * std::size_t n = aligner.pop(out_ptrs, aligner.available());
+     * @endcode
+     */
+    class BoardAligner
+    {
+    public:
+        /**
+         * @param fir_taps even number of fractional delay taps, eg 16, 0 for integer alignment only
+         */
+        explicit BoardAligner(std::size_t fir_taps = 0);
+
+        static int readAdcDelay(int board_no, sint32& delay);
+
+        /**
+         * @param delay in samples, may be fractional
+         * @return index of the group for push()
+         */
+        std::size_t addGroup(std::size_t channel_count, double delay);
+
+        std::size_t getGroupCount() const;
+        std::size_t getChannelCount() const;
+
+        /**
+         * Output sample n belongs to the delay free sample index n + getLatency()
+         */
+        std::size_t getLatency() const;
+
+        /**
+         * Discard all buffered samples, eg on a new acquisition.
+         */
+        void reset();
+
+        /**
+         * Append count samples of each channel of a group.
+         * @param channels channel_count pointers
+         */
+        void push(std::size_t group, const float* const* channels, std::size_t count);
+
+        /**
+         * Number of aligned samples ready for pop()
+         */
+        std::size_t available() const;
+
+        /**
+         * Fetch aligned samples of all channels.
+         * @param channels one pointer per channel, in the order the groups were added
+         * @return number of samples written per channel
+         */
+        std::size_t pop(float* const* channels, std::size_t count);
+
+    private:
+        struct Group
+        {
+            std::size_t first_channel;
+            uint64_t start;                     //!< first input index used for output sample 0
+            std::vector<float> taps;            //!< empty for integer delays
+            std::vector<std::vector<float>> data;
+            uint64_t base;                      //!< input index of data[c][0]
+            uint64_t pushed;
+        };
+
+        void computeTaps(double fraction, std::vector<float>& taps) const;
+        static void filter(const float* in, const float* taps, std::size_t tap_count, float* out, std::size_t count);
+
+    private:
+        std::size_t m_fir_taps;
+        std::size_t m_channel_count;
+        std::vector<Group> m_groups;
+        uint64_t m_produced;
+    };
+
+} // trion
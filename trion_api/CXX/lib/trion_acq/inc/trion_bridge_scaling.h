@@ -0,0 +1,211 @@
+// Copyright (c) DEWETRON GmbH 2026
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace trion
+{
+    class ScanDescriptor;
+
+    /**
+     * Strain gauge arrangement of a bridge channel.
+     */
+    enum class BridgeType
+    {
+        QUARTER,        //!< one active gauge
+        HALF_BENDING,   //!< two active gauges, opposite strain
+        HALF_POISSON,   //!< axial and transverse gauge
+        FULL_BENDING,   //!< four active gauges, pairwise opposite strain
+        FULL_POISSON,   //!< two axial and two transverse gauges
+    };
+
+    /**
+     * Engineering unit a bridge channel is converted to.
+     */
+    enum class BridgeOutput
+    {
+        MV_PER_V,       //!< balanced bridge output
+        STRAIN,         //!< um/m, from bridge type, gauge factor and poisson ratio
+        LOAD,           //!< unit of rated_load, from the sensitivity of a transducer
+        POLYNOMIAL,     //!< user polynomial in mV/V
+    };
+
+    struct BridgeSensor
+    {
+        BridgeOutput output;
+        BridgeType type;
+        double gauge_factor;                //!< STRAIN
+        double poisson;                     //!< STRAIN, *_POISSON types
+        double sensitivity;                 //!< LOAD, mV/V at rated load
+        double rated_load;                  //!< LOAD
+        std::vector<double> polynomial;     //!< POLYNOMIAL, c0 + c1 * x + c2 * x^2 ..., x in mV/V
+
+        BridgeSensor()
+            : output(BridgeOutput::MV_PER_V)
+            , type(BridgeType::QUARTER)
+            , gauge_factor(2.0)
+            , poisson(0.3)
+            , sensitivity(2.0)
+            , rated_load(1.0)
+        {
+        }
+    };
+
+    /**
+     * Converts raw bridge samples to mV/V, strain or load in one pass.
+     *
+     * The raw scaling of the range ("scalevalue", "scaleoffset"), the
+     * sensor balance zero and the sensor transform are folded into one
+     * table entry per channel: an affine transform of the raw value, or
+     * an affine transform to mV/V followed by a polynomial. Non linear
+     * bridge equations, like the quarter bridge, are expanded into a
+     * polynomial with a relative error below 1e-6 up to 10 mV/V.
+     *
+     * The table is immutable while a block is processed. Changing the
+     * balance or a sensor builds a new table and swaps it atomically, so
+     * a sensor balance during the measurement ("SensorOffset" with a
+     * running acquisition) does not need to stop processing. Each block
+     * is scaled consistently with either the old or the new table.
+     *
+     * @code
+     * trion::BridgeScaling scaling;
+     * trion::BridgeSensor sensor;
+     * sensor.output = trion::BridgeOutput::STRAIN;
+     * scaling.addChannel(0, sd, "AI0", sensor);
+     * ...
+     * scaling.process(read_pos, avail_samples, buf_end_pos, buf_size, outputs);
+     *
+     * // from a control thread, after the balancing finished
+     * scaling.readSensorOffset(0);
+     * @endcode
+     */
+    class BridgeScaling
+    {
+    public:
+        static const std::size_t INVALID_CHANNEL = static_cast<std::size_t>(-1);
+
+        BridgeScaling();
+
+        /**
+         * Add a channel of the scan, the raw scaling is read from the board.
+         * Channels are numbered in the order they are added. All channels
+         * share one scan buffer, so they have to be of the same board.
+         * @return ERR_NONE, the API error, ERR_CHANNEL_NOT_AVAILABLE if the
+         *         channel is not part of the scan, ERR_INVALID_VALUE if the
+         *         scaling is not numeric or the scan size differs from the
+         *         other channels, ERR_INVALID_BOARD_NO if the other channels
+         *         are of another board
+         */
+        int addChannel(int board_no, const ScanDescriptor& sd, const std::string& name, const BridgeSensor& sensor);
+
+        /**
+         * Add a channel with known raw scaling, mV/V = raw * scale + scale_offset.
+         * The channel is not bound to a board.
+         * @param scan_size has to be the same for all channels
+         * @param offset byte offset within the scan
+         * @param bits sample size, signed
+         * @return channel number, INVALID_CHANNEL if the scan size differs
+         */
+        std::size_t addChannel(uint32_t scan_size, uint32_t offset, uint32_t bits,
+            double scale, double scale_offset, const std::string& name, const BridgeSensor& sensor);
+
+        std::size_t getChannelCount() const;
+
+        /**
+         * Balanced zero in mV/V, subtracted before the sensor transform.
+         */
+        void setZero(std::size_t channel, double zero);
+        void setSensor(std::size_t channel, const BridgeSensor& sensor);
+
+        /**
+         * Take the <Offset> results of the last sensor balance of the board
+         * as new zeros, instead of writing them to "InputOffset".
+         * @return ERR_NONE, the API error or ERR_INVALID_VALUE if the result
+         *         has no offsets of the added channels, eg while the balance
+         *         is still running
+         */
+        int readSensorOffset(int board_no);
+
+        /**
+         * Same for a "SensorOffset" result document of the board. Offsets
+         * of other boards and offsets with a Passed attribute other than
+         * "True", on the Offset element or one of its parents, are skipped.
+         * @return number of channels updated
+         */
+        std::size_t applySensorOffset(int board_no, const char* xml, std::size_t length);
+
+        /**
+         * Scale count scans.
+         * @param outputs one array of count values per channel
+         */
+        void process(const void* scans, std::size_t count, float* const* outputs);
+
+        /**
+         * Same for a block in the circular buffer, as given by CMD_BUFFER_0_ACT_SAMPLE_POS,
+         * CMD_BUFFER_0_END_POINTER and CMD_BUFFER_0_TOTAL_MEM_SIZE.
+         */
+        void process(int64_t read_pos, std::size_t count, int64_t buf_end_pos, int64_t buf_size, float* const* outputs);
+
+    private:
+        struct Channel
+        {
+            int board_no;           //!< -1 if added with known raw scaling
+            std::string name;
+            uint32_t offset;
+            uint32_t bits;
+            double scale;
+            double scale_offset;
+            double zero;
+            BridgeSensor sensor;
+        };
+
+        /**
+         * x = gain * raw + bias, then y = sum coefficients[k] * x^k if not empty
+         */
+        struct Transform
+        {
+            uint32_t offset;
+            uint32_t bytes;
+            uint32_t shift;
+            double gain;
+            double bias;
+            std::vector<double> coefficients;
+        };
+
+        struct Table
+        {
+            uint32_t scan_size;
+            std::vector<Transform> transforms;
+        };
+
+        static void sensorPolynomial(const BridgeSensor& sensor, std::vector<double>& coefficients);
+        static Transform buildTransform(const Channel& channel);
+        int insertChannel(int board_no, uint32_t scan_size, uint32_t offset, uint32_t bits,
+            double scale, double scale_offset, const std::string& name, const BridgeSensor& sensor,
+            std::size_t& index);
+        void publish();
+
+        void processBlock(const Table& table, const unsigned char* scans, std::size_t count,
+            float* const* outputs, std::size_t out_offset);
+
+    private:
+        // configuration, guarded by m_mutex
+        mutable std::mutex m_mutex;
+        uint32_t m_scan_size;
+        std::vector<Channel> m_channels;
+        std::vector<char> m_buffer;
+
+        std::shared_ptr<const Table> m_table;
+
+        // processing scratch
+        std::vector<int32_t> m_raw;
+        std::vector<double> m_x;
+        std::vector<double> m_y;
+    };
+
+} // trion
@@ -0,0 +1,157 @@
+// Copyright (c) DEWETRON GmbH 2026
+#pragma once
+
+#include "dewepxi_types.h"
+#include <chrono>
+#include <cstdint>
+
+namespace trion
+{
+    enum class BufferHealth
+    {
+        OK,
+        WARNING,        //!< shed optional work, enlarge blocks
+        CRITICAL,       //!< data loss is imminent
+    };
+
+    /**
+     * Fill level of one acquisition buffer and its board memory.
+     * Rates are in samples (scans) per second.
+     */
+    struct BufferStatus
+    {
+        int board_no;
+        uint64_t updates;
+        double time;                    //!< seconds since start()
+
+        sint32 avail_samples;           //!< CMD_BUFFER_0_AVAIL_NO_SAMPLE
+        sint32 capacity_samples;        //!< CMD_BUFFER_0_TOTAL_MEM_SIZE / CMD_BUFFER_0_ONE_SCAN_SIZE
+        sint32 avail_free_mem;          //!< CMD_BUFFER_0_AVAIL_FREE_MEM, bytes
+        sint32 board_mem_size;          //!< CMD_BUFFER_0_BOARD_MEM_SIZE, 0 if not supported
+        sint32 free_board_mem;          //!< CMD_BUFFER_0_FREE_BOARD_MEM_SIZE
+        sint32 board_samples;           //!< CMD_BUFFER_0_NUM_SAMPLES_IN_BOARD_MEM
+
+        double fill;                    //!< 0..1 of the host buffer
+        double board_fill;              //!< 0..1 of the board memory
+        double fill_high_water;
+        double board_fill_high_water;
+
+        double produce_rate;
+        double drain_rate;
+        double time_to_full;            //!< seconds at the current rates, infinity while draining
+    };
+
+    /**
+     * Receives the health changes of a BufferMonitor.
+     * All callbacks are invoked synchronously from BufferMonitor::update.
+     */
+    class BufferMonitorListener
+    {
+    public:
+        virtual ~BufferMonitorListener() {}
+
+        virtual void onHealthChanged(const BufferStatus& /*status*/, BufferHealth /*previous*/, BufferHealth /*health*/) {}
+    };
+
+    struct BufferMonitorConfig
+    {
+        double warning_fill;            //!< fill level for WARNING
+        double critical_fill;           //!< fill level for CRITICAL
+        double hysteresis;              //!< fill has to drop this much below a threshold to leave a level
+        double warning_time;            //!< seconds to full for WARNING
+        double critical_time;           //!< seconds to full for CRITICAL
+        double rate_smoothing;          //!< weight of a new rate measurement, 0..1
+        unsigned int board_poll_interval;   //!< board memory counters are read every n-th update
+
+        BufferMonitorConfig()
+            : warning_fill(0.5)
+            , critical_fill(0.8)
+            , hysteresis(0.05)
+            , warning_time(2.0)
+            , critical_time(0.5)
+            , rate_smoothing(0.2)
+            , board_poll_interval(8)
+        {
+        }
+    };
+
+    /**
+     * Early overrun warning for the acquisition buffer of one board.
+     *
+     * Call update() from the acquisition loop, or update(avail_samples)
+     * if the loop reads CMD_BUFFER_0_AVAIL_NO_SAMPLE anyway, and
+     * notifyFreed() along with CMD_BUFFER_0_FREE_NO_SAMPLE. The board
+     * memory counters are only read every board_poll_interval updates.
+     *
+     * The health is the worst of the host buffer fill, the board memory
+     * fill and the time until the buffer is full at the smoothed produce
+     * and drain rates.
+     *
+     * @code
+     * trion::BufferMonitor monitor(board, listener);
+     * monitor.start();
+     * while (acquiring)
+     * {
+     *     DeWeGetParam_i32(board, CMD_BUFFER_0_AVAIL_NO_SAMPLE, &avail_samples);
+     *     monitor.update(avail_samples);
+     *     ...
+     *     DeWeSetParam_i32(board, CMD_BUFFER_0_FREE_NO_SAMPLE, avail_samples);
+     *     monitor.notifyFreed(avail_samples);
+     * }
+     * @endcode
+     */
+    class BufferMonitor
+    {
+    public:
+        /**
+         * @param buffer DMA buffer index, commands are BUFFER_0_ + buffer * 0x20
+         */
+        BufferMonitor(int board_no, BufferMonitorListener& listener, int buffer = 0);
+
+        void setConfig(const BufferMonitorConfig& config);
+        const BufferMonitorConfig& getConfig() const;
+
+        /**
+         * Read the buffer geometry and reset the statistics.
+         * Call after CMD_START_ACQUISITION.
+         */
+        int start();
+
+        /**
+         * Read CMD_BUFFER_0_AVAIL_NO_SAMPLE and update.
+         */
+        int update();
+
+        /**
+         * Update with the available samples already read by the caller.
+         */
+        int update(sint32 avail_samples);
+
+        void notifyFreed(sint32 samples);
+
+        void resetHighWater();
+
+        BufferHealth getHealth() const;
+        const BufferStatus& getStatus() const;
+
+    private:
+        typedef std::chrono::steady_clock Clock;
+
+        unsigned int command(unsigned int buffer_0_command) const;
+        int pollBoardMemory();
+        void updateRates(sint32 avail_samples, Clock::time_point now);
+        BufferHealth evaluate() const;
+
+    private:
+        BufferMonitorListener& m_listener;
+        BufferMonitorConfig m_config;
+        int m_buffer;
+        BufferStatus m_status;
+        BufferHealth m_health;
+        bool m_board_memory;
+        sint64 m_freed;
+        Clock::time_point m_start;
+        Clock::time_point m_last;
+    };
+
+} // trion
@@ -0,0 +1,164 @@
+// Copyright (c) DEWETRON GmbH 2026
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace trion
+{
+    class ScanDescriptor;
+
+    /**
+     * Counter channel "Mode" as configured on the board.
+     */
+    enum class CounterMode
+    {
+        EVENTS,                 //!< "Events": cumulative event count
+        PERIOD,                 //!< "Period": period in time base ticks
+        PULSE_WIDTH,            //!< "PulseWidth": pulse width in time base ticks
+        TWO_PULSE_EDGE_SEP,     //!< "TwoPulseEdgeSep": edge separation in time base ticks
+        SUB_PERIOD,             //!< "Subcounter Period": pulse width ticks, sub counter period ticks
+        SUB_TWO_PULSE_EDGE_SEP, //!< "Subcounter TwoPulseEdgeSep": separation ticks, sub counter period ticks
+        SUB_FREQUENCY,          //!< "Subcounter Frequency": cumulative edges, sub counter time base ticks of the last edge
+        ENCODER,                //!< signed position, cumulative
+    };
+
+    struct CounterConfig
+    {
+        CounterMode mode;
+        double timebase;                    //!< Hz, 80 MHz on TRION counters
+        double sample_rate;                 //!< Hz, for the EVENTS frequency
+        uint32_t pulses_per_revolution;     //!< ENCODER
+        uint32_t edges_per_pulse;           //!< ENCODER, 4 for quadrature
+
+        CounterConfig()
+            : mode(CounterMode::EVENTS)
+            , timebase(80e6)
+            , sample_rate(0)
+            , pulses_per_revolution(1)
+            , edges_per_pulse(4)
+        {
+        }
+    };
+
+    /**
+     * Output arrays of CounterDecoder::decode, each count values long.
+     * Unused outputs are nullptr; outputs the mode does not provide are
+     * left untouched.
+     *
+     * - counts: EVENTS, SUB_FREQUENCY and ENCODER, 64 bit extended
+     * - frequency: Hz, all modes except PULSE_WIDTH, TWO_PULSE_EDGE_SEP and ENCODER
+     * - period: s, PERIOD and SUB_* modes
+     * - duty: 0..1, SUB_PERIOD, width / period; SUB_TWO_PULSE_EDGE_SEP, separation / period
+     * - time: s, PULSE_WIDTH, TWO_PULSE_EDGE_SEP and SUB_TWO_PULSE_EDGE_SEP
+     * - angle: degree, ENCODER, not wrapped at 360
+     */
+    struct CounterOutput
+    {
+        int64_t* counts;
+        double* frequency;
+        double* period;
+        double* duty;
+        double* time;
+        double* angle;
+
+        CounterOutput()
+            : counts(nullptr)
+            , frequency(nullptr)
+            , period(nullptr)
+            , duty(nullptr)
+            , time(nullptr)
+            , angle(nullptr)
+        {
+        }
+    };
+
+    /**
+     * Decodes the raw counter and sub counter words of one counter channel.
+     *
+     * The words are first gathered from the scans into contiguous arrays,
+     * then extended and converted in separate loops over the whole block.
+     * Cumulative counters roll over at their sample size and are extended
+     * to 64 bit across blocks.
+     *
+     * @code
+     * trion::CounterConfig config;
+     * config.mode = trion::CounterMode::ENCODER;
+     * config.pulses_per_revolution = 1024;
+     * trion::CounterDecoder decoder;
+     * decoder.configure(sd, "CNT0", config);
+     * trion::CounterOutput out;
+     * out.angle = angle.data();
+     * decoder.decode(read_pos, avail_samples, buf_end_pos, buf_size, out);
+     * @endcode
+     */
+    class CounterDecoder
+    {
+    public:
+        CounterDecoder();
+
+        /**
+         * @return false if the channel or a sub counter the mode needs is not part of the scan
+         */
+        bool configure(const ScanDescriptor& sd, const std::string& name, const CounterConfig& config);
+
+        /**
+         * Byte offsets within the scan, sub_offset is ignored by modes without sub counter.
+         */
+        void configure(uint32_t scan_size, uint32_t offset, uint32_t bits,
+            uint32_t sub_offset, uint32_t sub_bits, const CounterConfig& config);
+
+        bool isConfigured() const;
+        const CounterConfig& getConfig() const;
+
+        static bool usesSubCounter(CounterMode mode);
+
+        /**
+         * Forget the roll over state, eg on a new acquisition.
+         */
+        void reset();
+
+        void decode(const void* scans, std::size_t count, const CounterOutput& out);
+
+        /**
+         * Decode a block in the circular buffer, as given by CMD_BUFFER_0_ACT_SAMPLE_POS,
+         * CMD_BUFFER_0_END_POINTER and CMD_BUFFER_0_TOTAL_MEM_SIZE.
+         */
+        void decode(int64_t read_pos, std::size_t count, int64_t buf_end_pos, int64_t buf_size, const CounterOutput& out);
+
+    private:
+        void decodeBlock(const unsigned char* scans, std::size_t count, const CounterOutput& out, std::size_t out_offset);
+        void gather(const unsigned char* scans, std::size_t count, uint32_t offset, uint32_t mask, uint32_t* raw) const;
+        static void extend(const uint32_t* raw, std::size_t count, uint32_t mask, bool is_signed,
+            uint32_t& last, int64_t& total, int64_t* ext);
+
+    private:
+        CounterConfig m_config;
+        uint32_t m_scan_size;
+        uint32_t m_offset;
+        uint32_t m_mask;
+        uint32_t m_sub_offset;
+        uint32_t m_sub_mask;
+
+        // roll over state
+        bool m_started;
+        uint32_t m_last;
+        uint32_t m_sub_last;
+        int64_t m_total;
+        int64_t m_sub_total;
+
+        // SUB_FREQUENCY, counts at the last edge
+        int64_t m_edge_count;
+        int64_t m_edge_ticks;
+        uint64_t m_since_edge;
+        double m_frequency;
+
+        std::vector<uint32_t> m_raw;
+        std::vector<uint32_t> m_sub_raw;
+        std::vector<int64_t> m_ext;
+        std::vector<int64_t> m_sub_ext;
+    };
+
+} // trion
@@ -0,0 +1,161 @@
+// Copyright (c) DEWETRON GmbH 2026
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace trion
+{
+    class ScanDescriptor;
+
+    struct DataLossEvent
+    {
+        enum Kind
+        {
+            GAP,        //!< samples are missing before scan block_index
+            RESYNC,     //!< the counter jumped backwards, eg restarted acquisition
+        };
+
+        Kind kind;
+        std::size_t block_index;    //!< scan within the processed block
+        uint64_t position;          //!< sample position of the first lost sample
+        uint64_t length;            //!< number of lost samples, 0 for RESYNC
+    };
+
+    enum class GapFill
+    {
+        NONE,
+        ZERO,
+        NAN_VALUE,      //!< quiet NaN for floating point, 0 for integer samples
+    };
+
+    /**
+     * Detects lost samples with a board counter counting ACQ_CLK.
+     *
+     * The counter is configured like in datalosthandling.c
+     * (Source_A = "ACQ_CLK", Reset = "OnRestart") and increments by one per
+     * scan. Each block is checked in chunks with a branch free compare of
+     * all counter values; only a chunk with a mismatch is searched for the
+     * exact positions. Sample positions are counted from the first scan
+     * after configure() or reset(), lost samples included.
+     *
+     * @code
+     * trion::ScanDescriptor sd;
+     * sd.read(board);
+     * trion::DataLossDetector detector;
+     * detector.configure(sd, "BoardCNT0");
+     * ...
+     * events.clear();
+     * detector.process(read_pos, avail_samples, buf_end_pos, buf_size, events);
+     * @endcode
+     */
+    class DataLossDetector
+    {
+    public:
+        DataLossDetector();
+
+        /**
+         * @return false if the counter channel is not part of the scan
+         */
+        bool configure(const ScanDescriptor& sd, const std::string& counter_name = "BoardCNT0");
+
+        /**
+         * @param scan_size bytes per scan
+         * @param counter_offset byte offset of the counter within the scan
+         * @param counter_bits counter width, the counter wraps at 2^counter_bits
+         */
+        void configure(uint32_t scan_size, uint32_t counter_offset, uint32_t counter_bits = 32);
+
+        bool isConfigured() const;
+
+        /**
+         * Start over, eg after CMD_START_ACQUISITION. The next scan is position 0.
+         */
+        void reset();
+
+        /**
+         * Check a contiguous block of scans.
+         * @return number of events appended
+         */
+        std::size_t process(const void* scans, std::size_t count, std::vector<DataLossEvent>& events);
+
+        /**
+         * Check a block in the circular buffer, as given by CMD_BUFFER_0_ACT_SAMPLE_POS,
+         * CMD_BUFFER_0_END_POINTER and CMD_BUFFER_0_TOTAL_MEM_SIZE.
+         * block_index of the events counts from read_pos.
+         */
+        std::size_t process(int64_t read_pos, std::size_t count, int64_t buf_end_pos, int64_t buf_size, std::vector<DataLossEvent>& events);
+
+        /**
+         * Position of the next expected sample
+         */
+        uint64_t getPosition() const;
+
+        uint64_t getLostSamples() const;
+        uint64_t getGapCount() const;
+
+    private:
+        uint32_t counterAt(const unsigned char* scans, std::size_t index) const;
+        std::size_t processBlock(const unsigned char* scans, std::size_t count,
+            std::size_t block_offset, std::vector<DataLossEvent>& events);
+        std::size_t searchChunk(const unsigned char* scans, std::size_t begin, std::size_t end,
+            std::size_t block_offset, std::vector<DataLossEvent>& events);
+
+    private:
+        uint32_t m_scan_size;
+        uint32_t m_counter_offset;
+        uint32_t m_counter_mask;
+        bool m_started;
+        uint32_t m_expected;
+        uint64_t m_position;
+        uint64_t m_lost;
+        uint64_t m_gaps;
+    };
+
+
+    template <typename T>
+    T getGapFillValue(GapFill fill)
+    {
+        if constexpr (std::is_floating_point<T>::value)
+        {
+            if (fill == GapFill::NAN_VALUE)
+            {
+                return std::numeric_limits<T>::quiet_NaN();
+            }
+        }
+        return T();
+    }
+
+    /**
+     * Copy the decoded samples of one channel for a processed block into
+     * out, with fill values inserted for the GAP events. Index n of the
+     * appended samples is then position first_position + n.
+     * With GapFill::NONE the samples are copied unchanged.
+     *
+     * @param max_fill longest gap that is filled, longer gaps are clamped
+     */
+    template <typename T>
+    void fillGaps(const T* samples, std::size_t count,
+        const std::vector<DataLossEvent>& events, GapFill fill,
+        std::vector<T>& out, uint64_t max_fill = 1u << 24)
+    {
+        const T value = getGapFillValue<T>(fill);
+        std::size_t copied = 0;
+        for (const auto& event : events)
+        {
+            if (fill == GapFill::NONE || event.kind != DataLossEvent::GAP || event.block_index > count)
+            {
+                continue;
+            }
+            out.insert(out.end(), samples + copied, samples + event.block_index);
+            copied = event.block_index;
+            out.insert(out.end(), static_cast<std::size_t>(event.length < max_fill ? event.length : max_fill), value);
+        }
+        out.insert(out.end(), samples + copied, samples + count);
+    }
+
+} // trion
@@ -0,0 +1,108 @@
+// Copyright (c) DEWETRON GmbH 2026
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace trion
+{
+    class ScanDescriptor;
+
+    struct DigitalEdge
+    {
+        std::size_t block_index;    //!< scan within the processed block
+        uint8_t line;
+        bool rising;
+    };
+
+    /**
+     * Decodes a discrete channel, one bit per line packed into each scan.
+     *
+     * gather() copies the packed words of a block out of the scans. The
+     * words can then be unpacked into one byte per sample and line, into
+     * bit planes with eight samples per byte, or scanned for edges.
+     *
+     * Edge extraction first ORs the changes of a chunk of words and skips
+     * chunks without changes, then visits only the changed bits, so a
+     * block with few toggles costs little more than the chunk check.
+     *
+     * @code
+     * trion::DigitalDecoder di;
+     * di.configure(sd, "Discret0");
+     * di.gather(read_pos, avail_samples, buf_end_pos, buf_size, words.data());
+     * edges.clear();
+     * di.extractEdges(words.data(), avail_samples, edges);
+     * @endcode
+     */
+    class DigitalDecoder
+    {
+    public:
+        DigitalDecoder();
+
+        /**
+         * @return false if the channel is not part of the scan
+         */
+        bool configure(const ScanDescriptor& sd, const std::string& name);
+
+        /**
+         * @param lines number of lines, the sample size in bits, up to 32
+         */
+        void configure(uint32_t scan_size, uint32_t offset, uint32_t lines);
+
+        bool isConfigured() const;
+        uint32_t getLineCount() const;
+
+        /**
+         * Forget the previous word, the next word does not produce edges.
+         */
+        void reset();
+
+        /**
+         * Copy the packed words of count scans, bit n is line n.
+         */
+        void gather(const void* scans, std::size_t count, uint32_t* words) const;
+
+        /**
+         * Same for a block in the circular buffer, as given by CMD_BUFFER_0_ACT_SAMPLE_POS,
+         * CMD_BUFFER_0_END_POINTER and CMD_BUFFER_0_TOTAL_MEM_SIZE.
+         */
+        void gather(int64_t read_pos, std::size_t count, int64_t buf_end_pos, int64_t buf_size, uint32_t* words) const;
+
+        /**
+         * Append the edges of a block of words, in sample order and
+         * ascending line order within a sample. The last word is kept
+         * for the next block.
+         * @return number of edges appended
+         */
+        std::size_t extractEdges(const uint32_t* words, std::size_t count, std::vector<DigitalEdge>& edges);
+
+        /**
+         * One byte, 0 or 1, per sample and line.
+         * @param lines one array of count bytes per line
+         */
+        static void unpackBytes(const uint32_t* words, std::size_t count, uint32_t line_count, uint8_t* const* lines);
+
+        /**
+         * Bit planes: byte n of a line holds samples 8n .. 8n+7, the
+         * first sample in bit 0. Uses an 8x8 bit matrix transpose.
+         * @param planes one array of (count + 7) / 8 bytes per line
+         */
+        static void unpackPlanes(const uint32_t* words, std::size_t count, uint32_t line_count, uint8_t* const* planes);
+
+    private:
+        void gatherBlock(const unsigned char* scans, std::size_t count, uint32_t* words) const;
+
+    private:
+        uint32_t m_scan_size;
+        uint32_t m_offset;
+        uint32_t m_lines;
+        uint32_t m_bytes;
+        uint32_t m_mask;
+
+        bool m_started;
+        uint32_t m_last;
+    };
+
+} // trion
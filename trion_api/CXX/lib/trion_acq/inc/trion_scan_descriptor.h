@@ -0,0 +1,79 @@
+// Copyright (c) DEWETRON GmbH 2026
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace trion
+{
+    /**
+     * One channel of a scan, offsets and sizes in bit as in the document.
+     */
+    struct ScanChannel
+    {
+        std::string name;           //!< API name, eg "AI0", "BoardCNT0"
+        std::string type;           //!< "Analog", "Counter", "Discrete"
+        uint32_t index;
+        uint32_t sample_offset;     //!< bit offset within the scan
+        uint32_t sample_size;       //!< bits
+        int sub_channel;            //!< counter sub channel, -1 if not given
+
+        uint32_t getByteOffset() const
+        {
+            return sample_offset / 8;
+        }
+    };
+
+    /**
+     * Parsed "ScanDescriptor_V3" document of one board.
+     *
+     * Only the used channels are listed, in the order of the document.
+     * Counter channels with sub channels have one entry per sub channel.
+     * Disabled boards return an empty descriptor with scan size 0.
+     */
+    class ScanDescriptor
+    {
+    public:
+        ScanDescriptor();
+
+        /**
+         * Read "ScanDescriptor_V3" of a board with DeWeGetParamStruct_str.
+         * @return ERR_NONE, the API error, or ERR_INVALID_VALUE if the document is invalid
+         */
+        int read(int board_no);
+
+        /**
+         * @return false for invalid documents or versions other than 3
+         */
+        bool parse(const char* xml, std::size_t length);
+        bool parse(const std::string& xml);
+
+        void clear();
+
+        /**
+         * Size of one scan in bytes
+         */
+        uint32_t getScanSize() const;
+
+        const std::vector<ScanChannel>& getChannels() const;
+
+        /**
+         * Case insensitive, "BoardCnt0" finds "BoardCNT0".
+         * @return nullptr if the channel is not part of the scan
+         */
+        const ScanChannel* findChannel(const std::string& name) const;
+
+        /**
+         * Sample of a counter sub channel, eg ("CNT0", 1)
+         */
+        const ScanChannel* findChannel(const std::string& name, int sub_channel) const;
+
+    private:
+        uint32_t m_scan_size;
+        std::vector<ScanChannel> m_channels;
+        std::vector<char> m_buffer;
+    };
+
+} // trion
@@ -0,0 +1,135 @@
+// Copyright (c) DEWETRON GmbH 2026
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace trion
+{
+    /**
+     * Linear calibration of a TEDS template, physical = gain * electrical + offset.
+     * Derived from MinPhysVal, MaxPhysVal, MinElecVal and MaxElecVal, the
+     * electrical value is in the unit of the template.
+     */
+    struct TedsScaling
+    {
+        bool valid;
+        double gain;
+        double offset;
+
+        TedsScaling()
+            : valid(false)
+            , gain(1.0)
+            , offset(0.0)
+        {
+        }
+    };
+
+    struct TedsChannel
+    {
+        int board_no;
+        int channel;
+        int error;                  //!< ERR_NONE, or eg ERROR_TEDS_NOT_FOUND
+        bool cached;                //!< true if the chain was not read again
+        uint64_t fingerprint;       //!< of ROM code and memory page 1, 0 if unknown
+        std::string serial;         //!< TEDSInfo/@Serial
+        std::string xml;            //!< "TedsReadExChain" document
+        TedsScaling scaling;
+
+        TedsChannel()
+            : board_no(0)
+            , channel(0)
+            , error(0)
+            , cached(false)
+            , fingerprint(0)
+        {
+        }
+    };
+
+    /**
+     * Reads the TEDS of all analog channels of several boards.
+     *
+     * Every board gets its own worker thread, so the slow 1-Wire
+     * transactions of the boards overlap. The channels of a board are read
+     * one after the other by its worker, no board is accessed by two
+     * threads. A channel is first probed by its ROM code ("TedsType") and
+     * memory page 1 ("TedsMem1"). If this fingerprint is known, the chain
+     * ("TedsReadExChain") is not read again. Known documents are kept in
+     * memory and, with a cache directory, in one file per fingerprint, so
+     * a restart with the same sensors only costs the probes.
+     *
+     * @code
+     * trion::TedsManager teds("teds_cache");
+     * teds.readAll({ 0, 1, 2, 3 });
+     * for (const auto& channel : teds.getChannels())
+     * {
+     *     if (channel.scaling.valid)
+     *     {
+     *         // eg a bridge template in V/V
+     *         sensor.output = trion::BridgeOutput::POLYNOMIAL;
+     *         sensor.polynomial = { channel.scaling.offset, channel.scaling.gain * 1e-3 };
+     *     }
+     * }
+     * @endcode
+     */
+    class TedsManager
+    {
+    public:
+        /**
+         * @param cache_dir existing directory for the on disk store, empty for memory only
+         */
+        explicit TedsManager(const std::string& cache_dir = std::string());
+
+        /**
+         * Read all AI channels of the boards, one worker per board.
+         * @return ERR_NONE or the first board level error, channel errors
+         *         are reported per channel
+         */
+        int readAll(const std::vector<int>& boards);
+
+        /**
+         * Read one channel in the calling thread.
+         */
+        TedsChannel readChannel(int board_no, int channel);
+
+        /**
+         * Results of the last readAll, ordered by board and channel.
+         */
+        const std::vector<TedsChannel>& getChannels() const;
+        const TedsChannel* findChannel(int board_no, int channel) const;
+
+        /**
+         * Scaling per channel of a board, invalid where there is no TEDS.
+         */
+        std::vector<TedsScaling> getScalingTable(int board_no) const;
+
+        /**
+         * Decode serial and scaling of a TEDS document.
+         */
+        static bool decode(const std::string& xml, std::string& serial, TedsScaling& scaling);
+
+        std::size_t getCacheSize() const;
+        void clearCache();
+
+    private:
+        int readBoard(int board_no, std::vector<TedsChannel>& channels);
+        int probe(int board_no, int channel, uint64_t& fingerprint);
+
+        bool lookup(uint64_t fingerprint, std::string& xml);
+        void store(uint64_t fingerprint, const std::string& xml);
+        std::string getCachePath(uint64_t fingerprint) const;
+
+    private:
+        std::string m_cache_dir;
+
+        mutable std::mutex m_cache_mutex;
+        std::map<uint64_t, std::string> m_cache;
+
+        std::vector<TedsChannel> m_channels;
+    };
+
+} // trion
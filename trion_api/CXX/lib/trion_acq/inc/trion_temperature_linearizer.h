@@ -0,0 +1,176 @@
+// Copyright (c) DEWETRON GmbH 2026
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace trion
+{
+    /**
+     * Piecewise cubic Hermite interpolation on uniform segments.
+     *
+     * Evaluation is an index computation, one table row and three
+     * multiply adds, independent of the order of the approximated
+     * function. Arguments outside the range extrapolate the first or
+     * last segment.
+     */
+    class PiecewiseCubic
+    {
+    public:
+        PiecewiseCubic();
+
+        /**
+         * Interpolate f with its derivative df on [x_min, x_max].
+         */
+        void build(const std::function<double(double)>& f, const std::function<double(double)>& df,
+            double x_min, double x_max, std::size_t segments);
+
+        bool empty() const;
+        double getMin() const;
+        double getMax() const;
+
+        double operator()(double x) const;
+        void evaluate(const float* x, std::size_t count, float* y) const;
+
+    private:
+        double m_x_min;
+        double m_x_max;
+        double m_scale;                         //!< segments per unit of x
+        double m_last;                          //!< index of the last segment
+        std::vector<double> m_coefficients;     //!< c0..c3 per segment, in t = 0..1
+    };
+
+    /**
+     * Thermocouple types with NIST ITS-90 reference functions.
+     */
+    enum class ThermocoupleType
+    {
+        B,
+        E,
+        J,
+        K,
+        N,
+        R,
+        S,
+        T,
+    };
+
+    /**
+     * Thermocouple voltage to temperature with cold junction compensation.
+     *
+     * The reference function E(t) and its inverse are precomputed into
+     * piecewise cubic tables once per type and shared by all instances, so
+     * a scanner with many channels of the same type pays for the tables
+     * once and per sample only for two table lookups instead of the
+     * evaluation of high order polynomials.
+     *
+     * The interpolation error is below 0.001 degC within the range of the
+     * NIST inverse functions. Voltages are in mV, temperatures in degC.
+     *
+     * @code
+     * trion::ThermocoupleLinearizer tc(trion::ThermocoupleType::K);
+     * tc.linearize(mv.data(), cjc.data(), count, celsius.data());
+     * @endcode
+     */
+    class ThermocoupleLinearizer
+    {
+    public:
+        explicit ThermocoupleLinearizer(ThermocoupleType type);
+
+        ThermocoupleType getType() const;
+        double getMinTemperature() const;
+        double getMaxTemperature() const;
+
+        /**
+         * Exact reference function, mV at degC with the reference junction at 0 degC.
+         */
+        static double referenceVoltage(ThermocoupleType type, double celsius);
+
+        double toVoltage(double celsius) const;
+        double toTemperature(double mv) const;
+
+        /**
+         * @param cjc cold junction temperature, for the whole block
+         */
+        void linearize(const float* mv, std::size_t count, double cjc, float* celsius) const;
+
+        /**
+         * @param cjc cold junction temperature per sample, eg the linearized reference channel
+         */
+        void linearize(const float* mv, const float* cjc, std::size_t count, float* celsius) const;
+
+    private:
+        struct Tables
+        {
+            PiecewiseCubic voltage;         //!< degC -> mV
+            PiecewiseCubic temperature;     //!< mV -> degC
+        };
+
+        static std::shared_ptr<const Tables> getTables(ThermocoupleType type);
+
+    private:
+        ThermocoupleType m_type;
+        std::shared_ptr<const Tables> m_tables;
+    };
+
+    /**
+     * Callendar-Van Dusen coefficients, IEC 60751 by default.
+     */
+    struct RtdCoefficients
+    {
+        double r0;      //!< Ohm at 0 degC, 100 for PT100
+        double a;
+        double b;
+        double c;       //!< below 0 degC only
+
+        RtdCoefficients()
+            : r0(100.0)
+            , a(3.9083e-3)
+            , b(-5.775e-7)
+            , c(-4.183e-12)
+        {
+        }
+    };
+
+    /**
+     * RTD resistance to temperature, -200 to 850 degC.
+     *
+     * The inverse of the Callendar-Van Dusen equation is precomputed over
+     * R / R0, the table does not depend on R0.
+     */
+    class RtdLinearizer
+    {
+    public:
+        explicit RtdLinearizer(const RtdCoefficients& coefficients = RtdCoefficients());
+
+        const RtdCoefficients& getCoefficients() const;
+
+        /**
+         * Exact Callendar-Van Dusen equation.
+         */
+        double toResistance(double celsius) const;
+        double toTemperature(double ohm) const;
+
+        void linearize(const float* ohm, std::size_t count, float* celsius) const;
+
+    private:
+        RtdCoefficients m_coefficients;
+        PiecewiseCubic m_temperature;       //!< R / R0 -> degC
+    };
+
+
+    inline double PiecewiseCubic::operator()(double x) const
+    {
+        // clamped before the conversion, also for NaN
+        const double position = (x - m_x_min) * m_scale;
+        const double segment = !(position >= 0) ? 0.0 : (position >= m_last ? m_last : std::floor(position));
+        const double t = position - segment;
+        const double* c = m_coefficients.data() + 4 * static_cast<std::size_t>(segment);
+        return ((c[3] * t + c[2]) * t + c[1]) * t + c[0];
+    }
+
+} // trion
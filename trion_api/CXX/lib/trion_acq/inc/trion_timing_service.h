@@ -0,0 +1,177 @@
+// Copyright (c) DEWETRON GmbH 2026
+#pragma once
+
+#include "dewepxi_types.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace trion
+{
+    enum class TimeScale
+    {
+        UTC,        //!< nanoseconds since 1970-01-01 UTC, without leap seconds
+        TAI,        //!< UTC + TAI-UTC offset
+    };
+
+    struct TimeAnchor
+    {
+        uint64_t sample;    //!< acquired sample count
+        int64_t utc_ns;     //!< UTC nanoseconds of that sample
+    };
+
+    struct TimingStatus
+    {
+        int board_no;
+        sint32 state;               //!< CMD_TIMING_STATE, TIMINGSTATE_*
+        bool valid;                 //!< a model is available
+        std::size_t anchors;        //!< anchors in the current fit
+        double ns_per_sample;
+        double drift_ppm;           //!< fitted rate against the nominal sample rate
+        double residual_ns;         //!< rms deviation of the anchors from the fit
+        uint64_t relocks;
+    };
+
+    /**
+     * Receives the timing state changes of a TimingService.
+     * All callbacks are invoked synchronously from TimingService::poll.
+     */
+    class TimingListener
+    {
+    public:
+        virtual ~TimingListener() {}
+
+        virtual void onTimingStateChanged(const TimingStatus& /*status*/, sint32 /*previous*/, sint32 /*state*/) {}
+
+        /**
+         * The board locked again after losing lock. The anchors taken
+         * before are discarded, the time base may have stepped.
+         */
+        virtual void onRelock(const TimingStatus& /*status*/) {}
+    };
+
+    /**
+     * Maps acquired sample counts to absolute time.
+     *
+     * poll() watches CMD_TIMING_STATE and, while locked, reads the time:
+     * the Get of CMD_TIMING_TIME latches AcqProp/Timing/SystemTime, the
+     * acquired sample count is read with CMD_BOARD_ACT_SAMPLE_COUNT right
+     * before and after the latch and the middle of both is taken. Year,
+     * Day and Sec are only parsed here, at the poll rate, not per block.
+     *
+     * Sec has a resolution of one second, so a single reading is off by
+     * up to one second. An anchor is only taken when Sec changed since the
+     * previous poll: the second started between the two readings, the
+     * anchor is the middle of them. Its error is at most half the poll
+     * interval, 250ms at the usual 500ms.
+     *
+     * The anchors of ANCHOR_SPACING_S seconds are averaged into one stored
+     * anchor, the MAX_ANCHORS stored anchors span 16 minutes. A least
+     * squares line through them gives the time, good to some 10ms with
+     * 500ms polls. Its rate corrects the drift between the sample clock
+     * and the time source once half of the anchors are taken, before the
+     * nominal rate is used. The rate is good to some 50 ppm then and to
+     * some 15 ppm with all anchors, the drift of a locked board is usually
+     * below that. Conversions only use the fitted line and are O(1) per
+     * sample.
+     *
+     * @code
+     * trion::TimingService timing(board, sample_rate, listener);
+     * // every 500ms
+     * timing.poll();
+     * // per block
+     * timing.toTime(block_first_sample, block_size, timestamps);
+     * @endcode
+     */
+    class TimingService
+    {
+    public:
+        enum
+        {
+            MAX_ANCHORS = 32,
+            ANCHOR_SPACING_S = 30,
+        };
+
+        TimingService(int board_no, double sample_rate, TimingListener& listener);
+
+        /**
+         * TAI-UTC in seconds, 37 since 2017
+         */
+        void setLeapSeconds(int tai_minus_utc);
+        int getLeapSeconds() const;
+
+        /**
+         * Discard all anchors, eg after CMD_START_ACQUISITION.
+         */
+        void reset();
+
+        /**
+         * Check the timing state and take an anchor while locked.
+         */
+        int poll();
+
+        /**
+         * Add an anchor from another source, eg GPS.
+         * A sample count lower than the last one starts a new model.
+         */
+        void addAnchor(uint64_t sample, int64_t utc_ns);
+
+        bool isValid() const;
+        const TimingStatus& getStatus() const;
+
+        int64_t toTime(uint64_t sample, TimeScale scale = TimeScale::UTC) const;
+
+        /**
+         * Convert count consecutive samples starting at first_sample.
+         */
+        void toTime(uint64_t first_sample, std::size_t count, int64_t* ns, TimeScale scale = TimeScale::UTC) const;
+
+        void toTime(const uint64_t* samples, std::size_t count, int64_t* ns, TimeScale scale = TimeScale::UTC) const;
+
+        /**
+         * Nearest sample of a UTC or TAI time, may be negative before the acquisition start.
+         */
+        int64_t toSample(int64_t ns, TimeScale scale = TimeScale::UTC) const;
+
+        /**
+         * UTC nanoseconds of year, day of year (1 based) and seconds of day
+         * as reported in AcqProp/Timing/SystemTime.
+         */
+        static int64_t toUtcNanoseconds(int year, int day_of_year, double second_of_day);
+
+    private:
+        int readAnchor(TimeAnchor& anchor, bool& taken);
+        int readTimeElement(const char* item, double& value);
+        void storeAnchor(uint64_t sample, int64_t utc_ns);
+        void fit();
+        int64_t scaleOffset(TimeScale scale) const;
+
+    private:
+        TimingListener& m_listener;
+        double m_nominal_ns_per_sample;
+        int m_leap_seconds;
+        std::string m_target;
+        TimingStatus m_status;
+        bool m_was_locked;
+
+        TimeAnchor m_anchors[MAX_ANCHORS];
+        std::size_t m_anchor_count;
+        std::size_t m_anchor_next;
+
+        // anchors averaged into the next stored one, relative to the first
+        std::size_t m_bin_count;
+        TimeAnchor m_bin_first;
+        int64_t m_bin_sample_sum;
+        int64_t m_bin_ns_sum;
+
+        // previous reading, to find the start of a second
+        bool m_poll_valid;
+        uint64_t m_poll_sample;
+        int64_t m_poll_second_ns;
+
+        // fitted line, time = m_base_ns + (sample - m_base_sample) * ns_per_sample
+        uint64_t m_base_sample;
+        int64_t m_base_ns;
+    };
+
+} // trion
@@ -0,0 +1,198 @@
+// Copyright (c) DEWETRON GmbH 2026
+
+#include "trion_block_tuner.h"
+#include "dewepxi_apicore.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace
+{
+    const double HISTOGRAM_MIN = 1e-6;
+
+    /**
+     * Loop time percentile used by adapt()
+     */
+    const double LOOP_QUANTILE = 0.99;
+
+    /**
+     * The block period has to be this multiple of the loop time
+     */
+    const double LOOP_HEADROOM = 2.0;
+
+    const sint32 MAX_BLOCK_COUNT = 10000;
+
+} // namespace
+
+
+namespace trion
+{
+    LatencyHistogram::LatencyHistogram()
+    {
+        reset();
+    }
+
+    void LatencyHistogram::add(double seconds)
+    {
+        int bucket = 0;
+        if (seconds > HISTOGRAM_MIN)
+        {
+            bucket = static_cast<int>(std::ceil(std::log2(seconds / HISTOGRAM_MIN) * BUCKETS_PER_OCTAVE));
+            bucket = std::min(bucket, static_cast<int>(BUCKET_COUNT) - 1);
+        }
+        ++m_buckets[bucket];
+        ++m_count;
+        m_max = std::max(m_max, seconds);
+    }
+
+    void LatencyHistogram::reset()
+    {
+        std::memset(m_buckets, 0, sizeof(m_buckets));
+        m_count = 0;
+        m_max = 0;
+    }
+
+    uint64_t LatencyHistogram::getCount() const
+    {
+        return m_count;
+    }
+
+    double LatencyHistogram::getMax() const
+    {
+        return m_max;
+    }
+
+    double LatencyHistogram::getQuantile(double q) const
+    {
+        if (m_count == 0)
+        {
+            return 0;
+        }
+        const uint64_t rank = static_cast<uint64_t>(std::ceil(q * m_count));
+        uint64_t sum = 0;
+        for (int bucket = 0; bucket < BUCKET_COUNT; ++bucket)
+        {
+            sum += m_buckets[bucket];
+            if (sum >= rank && sum > 0)
+            {
+                // the last bucket is open ended
+                const double upper = HISTOGRAM_MIN * std::exp2(static_cast<double>(bucket) / BUCKETS_PER_OCTAVE);
+                return bucket == BUCKET_COUNT - 1 ? m_max : std::min(upper, m_max);
+            }
+        }
+        return m_max;
+    }
+
+
+    BlockTuning BlockTuner::compute(const BlockRequirements& req)
+    {
+        return fit(req, req.latency / 2, true);
+    }
+
+    std::vector<BlockTuning> BlockTuner::compute(const std::vector<BlockRequirements>& reqs, uint64_t total_budget)
+    {
+        double total_rate = 0;
+        for (const auto& req : reqs)
+        {
+            total_rate += req.scan_size * req.sample_rate;
+        }
+
+        std::vector<BlockTuning> tunings;
+        tunings.reserve(reqs.size());
+        for (const auto& req : reqs)
+        {
+            BlockRequirements share = req;
+            share.memory_budget = total_rate > 0
+                ? static_cast<uint64_t>(total_budget * (req.scan_size * req.sample_rate / total_rate))
+                : 0;
+            tunings.push_back(compute(share));
+        }
+        return tunings;
+    }
+
+    BlockTuning BlockTuner::fit(const BlockRequirements& req, double block_time, bool latency_met)
+    {
+        BlockTuning tuning;
+        tuning.latency_met = latency_met;
+        tuning.buffer_time_met = true;
+
+        tuning.block_size = std::max(1, static_cast<sint32>(req.sample_rate * block_time));
+
+        const double blocks = std::ceil(req.buffer_time * req.sample_rate / tuning.block_size);
+        tuning.block_count = static_cast<sint32>(std::min(std::max(blocks, static_cast<double>(MIN_BLOCK_COUNT)),
+            static_cast<double>(MAX_BLOCK_COUNT)));
+
+        const uint64_t block_bytes = static_cast<uint64_t>(tuning.block_size) * req.scan_size;
+        if (block_bytes > 0 && block_bytes * tuning.block_count > req.memory_budget)
+        {
+            tuning.buffer_time_met = false;
+            tuning.block_count = static_cast<sint32>(req.memory_budget / block_bytes);
+            if (tuning.block_count < MIN_BLOCK_COUNT)
+            {
+                // smaller blocks still keep MIN_BLOCK_COUNT in flight
+                tuning.block_count = MIN_BLOCK_COUNT;
+                tuning.block_size = std::max<sint32>(1, static_cast<sint32>(req.memory_budget / req.scan_size / MIN_BLOCK_COUNT));
+            }
+        }
+        return tuning;
+    }
+
+    BlockTuner::BlockTuner(const BlockRequirements& req)
+        : m_req(req)
+        , m_tuning(compute(req))
+    {
+    }
+
+    const BlockRequirements& BlockTuner::getRequirements() const
+    {
+        return m_req;
+    }
+
+    const BlockTuning& BlockTuner::getTuning() const
+    {
+        return m_tuning;
+    }
+
+    int BlockTuner::apply(int board_no) const
+    {
+        int err = DeWeSetParam_i32(board_no, CMD_BUFFER_BLOCK_SIZE, m_tuning.block_size);
+        if (err > 0)
+        {
+            return err;
+        }
+        return DeWeSetParam_i32(board_no, CMD_BUFFER_BLOCK_COUNT, m_tuning.block_count);
+    }
+
+    void BlockTuner::recordLoop(double seconds)
+    {
+        m_histogram.add(seconds);
+    }
+
+    const LatencyHistogram& BlockTuner::getHistogram() const
+    {
+        return m_histogram;
+    }
+
+    const BlockTuning& BlockTuner::adapt()
+    {
+        if (m_histogram.getCount() == 0)
+        {
+            return m_tuning;
+        }
+
+        const double loop = m_histogram.getQuantile(LOOP_QUANTILE);
+        const double min_block_time = loop * LOOP_HEADROOM;
+        double block_time = m_req.latency - loop;
+        bool latency_met = true;
+        if (block_time < min_block_time)
+        {
+            block_time = min_block_time;
+            latency_met = false;
+        }
+
+        m_tuning = fit(m_req, block_time, latency_met);
+        m_histogram.reset();
+        return m_tuning;
+    }
+
+} // trion
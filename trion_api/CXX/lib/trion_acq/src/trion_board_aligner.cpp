@@ -0,0 +1,209 @@
+// Copyright (c) DEWETRON GmbH 2026
+
+#include "trion_board_aligner.h"
+#include "dewepxi_apicore.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace
+{
+    const double PI = 3.14159265358979323846;
+
+    /**
+     * Consumed input is only erased from the front beyond this many samples
+     */
+    const std::size_t COMPACT_THRESHOLD = 4096;
+
+    double sinc(double x)
+    {
+        return x == 0 ? 1.0 : std::sin(PI * x) / (PI * x);
+    }
+
+} // namespace
+
+
+namespace trion
+{
+    BoardAligner::BoardAligner(std::size_t fir_taps)
+        : m_fir_taps(fir_taps & ~std::size_t(1))
+        , m_channel_count(0)
+        , m_produced(0)
+    {
+    }
+
+    int BoardAligner::readAdcDelay(int board_no, sint32& delay)
+    {
+        return DeWeGetParam_i32(board_no, CMD_BOARD_ADC_DELAY, &delay);
+    }
+
+    std::size_t BoardAligner::addGroup(std::size_t channel_count, double delay)
+    {
+        Group group;
+        group.first_channel = m_channel_count;
+        group.data.resize(channel_count);
+        group.base = 0;
+        group.pushed = 0;
+
+        if (m_fir_taps == 0)
+        {
+            group.start = static_cast<uint64_t>(std::max(0.0, std::round(delay)));
+        }
+        else
+        {
+            const double whole = std::floor(std::max(0.0, delay));
+            const double fraction = std::max(0.0, delay) - whole;
+            group.start = static_cast<uint64_t>(whole);
+            if (fraction > 0)
+            {
+                computeTaps(fraction, group.taps);
+            }
+            else
+            {
+                // no filter needed, same latency as the filtered groups
+                group.start += getLatency();
+            }
+        }
+
+        m_channel_count += channel_count;
+        m_groups.push_back(std::move(group));
+        return m_groups.size() - 1;
+    }
+
+    std::size_t BoardAligner::getGroupCount() const
+    {
+        return m_groups.size();
+    }
+
+    std::size_t BoardAligner::getChannelCount() const
+    {
+        return m_channel_count;
+    }
+
+    std::size_t BoardAligner::getLatency() const
+    {
+        return m_fir_taps > 0 ? m_fir_taps / 2 - 1 : 0;
+    }
+
+    void BoardAligner::reset()
+    {
+        for (auto& group : m_groups)
+        {
+            for (auto& channel : group.data)
+            {
+                channel.clear();
+            }
+            group.base = 0;
+            group.pushed = 0;
+        }
+        m_produced = 0;
+    }
+
+    void BoardAligner::computeTaps(double fraction, std::vector<float>& taps) const
+    {
+        // sinc centered at the fractional position, Blackman window
+        const double center = static_cast<double>(getLatency()) + fraction;
+        const double width = static_cast<double>(m_fir_taps);
+        std::vector<double> h(m_fir_taps);
+        double sum = 0;
+        for (std::size_t k = 0; k < m_fir_taps; ++k)
+        {
+            const double x = center - static_cast<double>(k);
+            const double window = 0.42 + 0.5 * std::cos(2 * PI * x / width) + 0.08 * std::cos(4 * PI * x / width);
+            h[k] = sinc(x) * window;
+            sum += h[k];
+        }
+
+        // unity gain at DC
+        taps.resize(m_fir_taps);
+        for (std::size_t k = 0; k < m_fir_taps; ++k)
+        {
+            taps[k] = static_cast<float>(h[k] / sum);
+        }
+    }
+
+    void BoardAligner::push(std::size_t group_index, const float* const* channels, std::size_t count)
+    {
+        Group& group = m_groups.at(group_index);
+        for (std::size_t c = 0; c < group.data.size(); ++c)
+        {
+            group.data[c].insert(group.data[c].end(), channels[c], channels[c] + count);
+        }
+        group.pushed += count;
+    }
+
+    std::size_t BoardAligner::available() const
+    {
+        if (m_groups.empty())
+        {
+            return 0;
+        }
+
+        uint64_t ready = UINT64_MAX;
+        for (const auto& group : m_groups)
+        {
+            const uint64_t span = group.taps.empty() ? 1 : group.taps.size();
+            const uint64_t needed = group.start + span - 1;
+            const uint64_t outputs = group.pushed > needed ? group.pushed - needed : 0;
+            ready = std::min(ready, outputs);
+        }
+        return ready > m_produced ? static_cast<std::size_t>(ready - m_produced) : 0;
+    }
+
+    void BoardAligner::filter(const float* in, const float* taps, std::size_t tap_count, float* out, std::size_t count)
+    {
+        // tap major, the inner loop is a plain multiply add over the block
+        std::fill(out, out + count, 0.0f);
+        for (std::size_t k = 0; k < tap_count; ++k)
+        {
+            const float h = taps[k];
+            const float* x = in + k;
+            for (std::size_t n = 0; n < count; ++n)
+            {
+                out[n] += h * x[n];
+            }
+        }
+    }
+
+    std::size_t BoardAligner::pop(float* const* channels, std::size_t count)
+    {
+        count = std::min(count, available());
+        if (count == 0)
+        {
+            return 0;
+        }
+
+        for (auto& group : m_groups)
+        {
+            const std::size_t offset = static_cast<std::size_t>(m_produced + group.start - group.base);
+            for (std::size_t c = 0; c < group.data.size(); ++c)
+            {
+                const float* in = group.data[c].data() + offset;
+                float* out = channels[group.first_channel + c];
+                if (group.taps.empty())
+                {
+                    std::memcpy(out, in, count * sizeof(float));
+                }
+                else
+                {
+                    filter(in, group.taps.data(), group.taps.size(), out, count);
+                }
+            }
+
+            // samples before the next output are not needed anymore
+            const std::size_t consumed = offset + count;
+            if (consumed >= COMPACT_THRESHOLD)
+            {
+                for (auto& channel : group.data)
+                {
+                    channel.erase(channel.begin(), channel.begin() + consumed);
+                }
+                group.base += consumed;
+            }
+        }
+
+        m_produced += count;
+        return count;
+    }
+
+} // trion
@@ -0,0 +1,517 @@
+// Copyright (c) DEWETRON GmbH 2026
+
+#include "trion_bridge_scaling.h"
+#include "trion_scan_descriptor.h"
+#include "dewepxi_apicxx.h"
+#include <pugixml.hpp>
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+namespace
+{
+    /**
+     * Terms of the series expansion of non linear bridge equations
+     */
+    const int SERIES_ORDER = 4;
+
+    bool equalsNoCase(const char* a, const char* b, std::size_t length)
+    {
+        for (std::size_t n = 0; n < length; ++n)
+        {
+            if (std::tolower(static_cast<unsigned char>(a[n])) != std::tolower(static_cast<unsigned char>(b[n])))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * "AI0" matches "AI0", "ai0" and "BoardID0/AI0"
+     */
+    bool matchesChannel(const char* text, const std::string& name)
+    {
+        const std::size_t length = std::strlen(text);
+        if (length < name.size() || !equalsNoCase(text + length - name.size(), name.c_str(), name.size()))
+        {
+            return false;
+        }
+        return length == name.size() || text[length - name.size() - 1] == '/';
+    }
+
+    /**
+     * Board number of "BoardID0" or "BoardId0/AI0"
+     */
+    bool parseBoardId(const char* text, int& board_no)
+    {
+        const char prefix[] = "BoardID";
+        const std::size_t prefix_size = sizeof(prefix) - 1;
+        if (std::strlen(text) <= prefix_size || !equalsNoCase(text, prefix, prefix_size))
+        {
+            return false;
+        }
+        char* end = nullptr;
+        const long value = std::strtol(text + prefix_size, &end, 10);
+        if (end == text + prefix_size || (*end != 0 && *end != '/') || value < 0)
+        {
+            return false;
+        }
+        board_no = static_cast<int>(value);
+        return true;
+    }
+
+    /**
+     * Board of a result node by the nearest element naming it, -1 if none
+     */
+    int findBoard(pugi::xml_node node)
+    {
+        int board_no = -1;
+        for (; node; node = node.parent())
+        {
+            if (parseBoardId(node.name(), board_no))
+            {
+                return board_no;
+            }
+            for (pugi::xml_attribute attr = node.first_attribute(); attr; attr = attr.next_attribute())
+            {
+                if (parseBoardId(attr.value(), board_no))
+                {
+                    return board_no;
+                }
+            }
+        }
+        return -1;
+    }
+
+    /**
+     * false if the node or one of its parents failed its check
+     */
+    bool isPassed(pugi::xml_node node)
+    {
+        const char passed[] = "Passed";
+        const char ok[] = "True";
+        for (; node; node = node.parent())
+        {
+            for (pugi::xml_attribute attr = node.first_attribute(); attr; attr = attr.next_attribute())
+            {
+                if (std::strlen(attr.name()) == sizeof(passed) - 1 && equalsNoCase(attr.name(), passed, sizeof(passed) - 1)
+                    && !(std::strlen(attr.value()) == sizeof(ok) - 1 && equalsNoCase(attr.value(), ok, sizeof(ok) - 1)))
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    bool parseDouble(const char* text, double& value)
+    {
+        char* end = nullptr;
+        value = std::strtod(text, &end);
+        if (end == text)
+        {
+            return false;
+        }
+        while (std::isspace(static_cast<unsigned char>(*end)))
+        {
+            ++end;
+        }
+        return *end == 0 && std::isfinite(value);
+    }
+
+    int readNumber(const std::string& target, const char* item, std::vector<char>& buffer, double& value)
+    {
+        std::size_t length = 0;
+        int err = DeWeGetParamStruct_str_buf(target.c_str(), item, buffer, length);
+        if (err != ERR_NONE)
+        {
+            return err;
+        }
+        return parseDouble(buffer.data(), value) ? ERR_NONE : ERR_INVALID_VALUE;
+    }
+
+} // namespace
+
+
+namespace trion
+{
+    BridgeScaling::BridgeScaling()
+        : m_scan_size(0)
+    {
+    }
+
+    int BridgeScaling::addChannel(int board_no, const ScanDescriptor& sd, const std::string& name, const BridgeSensor& sensor)
+    {
+        const ScanChannel* channel = sd.findChannel(name);
+        if (!channel || channel->sample_size == 0 || channel->sample_size > 32
+            || channel->getByteOffset() + (channel->sample_size + 7) / 8 > sd.getScanSize())
+        {
+            return ERR_CHANNEL_NOT_AVAILABLE;
+        }
+
+        const std::string target = "BoardID" + std::to_string(board_no) + "/" + name;
+        double scale = 0;
+        double scale_offset = 0;
+        int err = readNumber(target, "scalevalue", m_buffer, scale);
+        if (err != ERR_NONE)
+        {
+            return err;
+        }
+        err = readNumber(target, "scaleoffset", m_buffer, scale_offset);
+        if (err != ERR_NONE)
+        {
+            return err;
+        }
+
+        std::size_t index = 0;
+        return insertChannel(board_no, sd.getScanSize(), channel->getByteOffset(), channel->sample_size,
+            scale, scale_offset, name, sensor, index);
+    }
+
+    std::size_t BridgeScaling::addChannel(uint32_t scan_size, uint32_t offset, uint32_t bits,
+        double scale, double scale_offset, const std::string& name, const BridgeSensor& sensor)
+    {
+        std::size_t index = INVALID_CHANNEL;
+        insertChannel(-1, scan_size, offset, bits, scale, scale_offset, name, sensor, index);
+        return index;
+    }
+
+    int BridgeScaling::insertChannel(int board_no, uint32_t scan_size, uint32_t offset, uint32_t bits,
+        double scale, double scale_offset, const std::string& name, const BridgeSensor& sensor,
+        std::size_t& index)
+    {
+        // all channels share one scan buffer
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (const auto& added : m_channels)
+        {
+            if (board_no >= 0 && added.board_no >= 0 && added.board_no != board_no)
+            {
+                return ERR_INVALID_BOARD_NO;
+            }
+        }
+        if (!m_channels.empty() && scan_size != m_scan_size)
+        {
+            return ERR_INVALID_VALUE;
+        }
+
+        Channel channel;
+        channel.board_no = board_no;
+        channel.name = name;
+        channel.offset = offset;
+        channel.bits = std::min<uint32_t>(std::max<uint32_t>(bits, 1), 32);
+        channel.scale = scale;
+        channel.scale_offset = scale_offset;
+        channel.zero = 0;
+        channel.sensor = sensor;
+
+        m_scan_size = scan_size;
+        m_channels.push_back(channel);
+        publish();
+        index = m_channels.size() - 1;
+        return ERR_NONE;
+    }
+
+    std::size_t BridgeScaling::getChannelCount() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_channels.size();
+    }
+
+    void BridgeScaling::setZero(std::size_t channel, double zero)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_channels.at(channel).zero = zero;
+        publish();
+    }
+
+    void BridgeScaling::setSensor(std::size_t channel, const BridgeSensor& sensor)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_channels.at(channel).sensor = sensor;
+        publish();
+    }
+
+    int BridgeScaling::readSensorOffset(int board_no)
+    {
+        const std::string target = "BoardID" + std::to_string(board_no) + "/AIAll";
+        std::vector<char> buffer;
+        std::size_t length = 0;
+        int err = DeWeGetParamStruct_str_buf(target.c_str(), "SensorOffset", buffer, length);
+        if (err != ERR_NONE)
+        {
+            return err;
+        }
+        return applySensorOffset(board_no, buffer.data(), length) > 0 ? ERR_NONE : ERR_INVALID_VALUE;
+    }
+
+    std::size_t BridgeScaling::applySensorOffset(int board_no, const char* xml, std::size_t length)
+    {
+        pugi::xml_document doc;
+        if (!doc.load_buffer(xml, length))
+        {
+            return 0;
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        std::size_t updated = 0;
+        for (const pugi::xpath_node& node : doc.select_nodes("//Offset"))
+        {
+            const int offset_board = findBoard(node.node());
+            if ((offset_board >= 0 && offset_board != board_no) || !isPassed(node.node()))
+            {
+                continue;
+            }
+
+            double zero = 0;
+            if (!parseDouble(node.node().child_value(), zero))
+            {
+                continue;
+            }
+
+            // the nearest element naming a channel, by element name or attribute
+            Channel* match = nullptr;
+            for (pugi::xml_node parent = node.node().parent(); parent && !match; parent = parent.parent())
+            {
+                for (auto& channel : m_channels)
+                {
+                    if (channel.board_no >= 0 && channel.board_no != board_no)
+                    {
+                        continue;
+                    }
+                    bool found = matchesChannel(parent.name(), channel.name);
+                    for (pugi::xml_attribute attr = parent.first_attribute(); attr && !found; attr = attr.next_attribute())
+                    {
+                        found = matchesChannel(attr.value(), channel.name);
+                    }
+                    if (found)
+                    {
+                        match = &channel;
+                        break;
+                    }
+                }
+            }
+
+            if (match)
+            {
+                match->zero = zero;
+                ++updated;
+            }
+        }
+
+        if (updated > 0)
+        {
+            publish();
+        }
+        return updated;
+    }
+
+    void BridgeScaling::sensorPolynomial(const BridgeSensor& sensor, std::vector<double>& coefficients)
+    {
+        coefficients.clear();
+        switch (sensor.output)
+        {
+        case BridgeOutput::MV_PER_V:
+            coefficients = { 0.0, 1.0 };
+            break;
+
+        case BridgeOutput::LOAD:
+            coefficients = { 0.0, sensor.sensitivity != 0 ? sensor.rated_load / sensor.sensitivity : 0.0 };
+            break;
+
+        case BridgeOutput::POLYNOMIAL:
+            coefficients = sensor.polynomial;
+            if (coefficients.empty())
+            {
+                coefficients = { 0.0, 1.0 };
+            }
+            break;
+
+        case BridgeOutput::STRAIN:
+        {
+            // strain = m * r / (1 - q * r) with r in V/V, expanded into
+            // m * r * (1 + q * r + (q * r)^2 + ...)
+            const double k = sensor.gauge_factor;
+            const double nu = sensor.poisson;
+            double m = 0;
+            double q = 0;
+            switch (sensor.type)
+            {
+            case BridgeType::QUARTER:
+                m = 4 / k;
+                q = 2;
+                break;
+            case BridgeType::HALF_BENDING:
+                m = 2 / k;
+                break;
+            case BridgeType::HALF_POISSON:
+                m = 4 / (k * (1 + nu));
+                q = 2 * (1 - nu) / (1 + nu);
+                break;
+            case BridgeType::FULL_BENDING:
+                m = 1 / k;
+                break;
+            case BridgeType::FULL_POISSON:
+                m = 2 / (k * (1 + nu));
+                q = (1 - nu) / (1 + nu);
+                break;
+            }
+            if (!std::isfinite(m))
+            {
+                m = 0;
+            }
+
+            // x in mV/V, result in um/m
+            const int order = q != 0 ? SERIES_ORDER : 1;
+            coefficients.assign(order + 1, 0.0);
+            double term = 1e6 * m * 1e-3;
+            for (int j = 0; j < order; ++j)
+            {
+                coefficients[j + 1] = term;
+                term *= q * 1e-3;
+            }
+            break;
+        }
+        }
+    }
+
+    BridgeScaling::Transform BridgeScaling::buildTransform(const Channel& channel)
+    {
+        Transform transform;
+        transform.offset = channel.offset;
+        transform.bytes = (channel.bits + 7) / 8;
+        transform.shift = 32 - channel.bits;
+        transform.gain = channel.scale;
+        transform.bias = channel.scale_offset - channel.zero;
+
+        sensorPolynomial(channel.sensor, transform.coefficients);
+        while (transform.coefficients.size() > 1 && transform.coefficients.back() == 0)
+        {
+            transform.coefficients.pop_back();
+        }
+
+        // fold a linear sensor into the raw scaling
+        if (transform.coefficients.size() <= 2)
+        {
+            const double c0 = transform.coefficients[0];
+            const double c1 = transform.coefficients.size() > 1 ? transform.coefficients[1] : 0.0;
+            transform.gain *= c1;
+            transform.bias = c0 + c1 * transform.bias;
+            transform.coefficients.clear();
+        }
+        return transform;
+    }
+
+    void BridgeScaling::publish()
+    {
+        auto table = std::make_shared<Table>();
+        table->scan_size = m_scan_size;
+        table->transforms.reserve(m_channels.size());
+        for (const auto& channel : m_channels)
+        {
+            table->transforms.push_back(buildTransform(channel));
+        }
+        std::atomic_store(&m_table, std::shared_ptr<const Table>(std::move(table)));
+    }
+
+    void BridgeScaling::process(const void* scans, std::size_t count, float* const* outputs)
+    {
+        const std::shared_ptr<const Table> table = std::atomic_load(&m_table);
+        if (!table || table->scan_size == 0)
+        {
+            return;
+        }
+        processBlock(*table, static_cast<const unsigned char*>(scans), count, outputs, 0);
+    }
+
+    void BridgeScaling::process(int64_t read_pos, std::size_t count, int64_t buf_end_pos, int64_t buf_size, float* const* outputs)
+    {
+        // one table for the whole block, also across the wrap around
+        const std::shared_ptr<const Table> table = std::atomic_load(&m_table);
+        if (!table || table->scan_size == 0)
+        {
+            return;
+        }
+
+        // scans up to the end of the circular buffer
+        const uint32_t scan_size = table->scan_size;
+        const std::size_t first = static_cast<std::size_t>((buf_end_pos - read_pos) / scan_size);
+        if (first >= count)
+        {
+            processBlock(*table, reinterpret_cast<const unsigned char*>(read_pos), count, outputs, 0);
+            return;
+        }
+
+        processBlock(*table, reinterpret_cast<const unsigned char*>(read_pos), first, outputs, 0);
+        const int64_t wrapped_pos = read_pos + static_cast<int64_t>(first) * scan_size - buf_size;
+        processBlock(*table, reinterpret_cast<const unsigned char*>(wrapped_pos), count - first, outputs, first);
+    }
+
+    void BridgeScaling::processBlock(const Table& table, const unsigned char* scans, std::size_t count,
+        float* const* outputs, std::size_t out_offset)
+    {
+        if (count == 0)
+        {
+            return;
+        }
+        if (m_raw.size() < count)
+        {
+            m_raw.resize(count);
+            m_x.resize(count);
+            m_y.resize(count);
+        }
+
+        int32_t* raw = m_raw.data();
+        for (std::size_t c = 0; c < table.transforms.size(); ++c)
+        {
+            const Transform& transform = table.transforms[c];
+            float* out = outputs[c] + out_offset;
+
+            // gather and sign extend, only the bytes of the sample
+            const unsigned char* pos = scans + transform.offset;
+            for (std::size_t i = 0; i < count; ++i, pos += table.scan_size)
+            {
+                uint32_t value = 0;
+                std::memcpy(&value, pos, transform.bytes);
+                raw[i] = static_cast<int32_t>(value << transform.shift) >> transform.shift;
+            }
+
+            const double gain = transform.gain;
+            const double bias = transform.bias;
+            if (transform.coefficients.empty())
+            {
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    out[i] = static_cast<float>(gain * raw[i] + bias);
+                }
+                continue;
+            }
+
+            // Horner, one coefficient per pass over the block
+            double* x = m_x.data();
+            double* y = m_y.data();
+            const std::vector<double>& coefficients = transform.coefficients;
+            const double top = coefficients.back();
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                x[i] = gain * raw[i] + bias;
+                y[i] = top;
+            }
+            for (std::size_t k = coefficients.size() - 1; k-- > 0;)
+            {
+                const double ck = coefficients[k];
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    y[i] = y[i] * x[i] + ck;
+                }
+            }
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                out[i] = static_cast<float>(y[i]);
+            }
+        }
+    }
+
+} // trion
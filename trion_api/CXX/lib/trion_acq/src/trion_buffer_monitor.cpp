@@ -0,0 +1,226 @@
+// Copyright (c) DEWETRON GmbH 2026
+
+#include "trion_buffer_monitor.h"
+#include "dewepxi_apicore.h"
+#include <algorithm>
+#include <limits>
+
+namespace
+{
+    /**
+     * Command offset between BUFFER_0_ and BUFFER_1_
+     */
+    const unsigned int BUFFER_COMMAND_OFFSET = 0x20;
+
+    /**
+     * While at a level, the time to full has to exceed the threshold
+     * by this factor to leave it again
+     */
+    const double TIME_HYSTERESIS = 2.0;
+
+    double ratio(sint32 value, sint32 total)
+    {
+        return total > 0 ? static_cast<double>(value) / total : 0.0;
+    }
+
+} // namespace
+
+
+namespace trion
+{
+    BufferMonitor::BufferMonitor(int board_no, BufferMonitorListener& listener, int buffer)
+        : m_listener(listener)
+        , m_config()
+        , m_buffer(buffer)
+        , m_status()
+        , m_health(BufferHealth::OK)
+        , m_board_memory(false)
+        , m_freed(0)
+    {
+        m_status.board_no = board_no;
+        m_status.time_to_full = std::numeric_limits<double>::infinity();
+    }
+
+    void BufferMonitor::setConfig(const BufferMonitorConfig& config)
+    {
+        m_config = config;
+    }
+
+    const BufferMonitorConfig& BufferMonitor::getConfig() const
+    {
+        return m_config;
+    }
+
+    unsigned int BufferMonitor::command(unsigned int buffer_0_command) const
+    {
+        return buffer_0_command + m_buffer * BUFFER_COMMAND_OFFSET;
+    }
+
+    int BufferMonitor::start()
+    {
+        const int board_no = m_status.board_no;
+        m_status = BufferStatus();
+        m_status.board_no = board_no;
+        m_status.time_to_full = std::numeric_limits<double>::infinity();
+        m_health = BufferHealth::OK;
+        m_freed = 0;
+
+        sint32 total_size = 0;
+        sint32 scan_size = 0;
+        int err = DeWeGetParam_i32(board_no, command(CMD_BUFFER_0_TOTAL_MEM_SIZE), &total_size);
+        if (err > 0)
+        {
+            return err;
+        }
+        err = DeWeGetParam_i32(board_no, command(CMD_BUFFER_0_ONE_SCAN_SIZE), &scan_size);
+        if (err > 0)
+        {
+            return err;
+        }
+        m_status.capacity_samples = scan_size > 0 ? total_size / scan_size : 0;
+
+        // not every board reports its on-board memory
+        sint32 board_mem_size = 0;
+        m_board_memory = DeWeGetParam_i32(board_no, command(CMD_BUFFER_0_BOARD_MEM_SIZE), &board_mem_size) <= 0
+            && board_mem_size > 0;
+        m_status.board_mem_size = m_board_memory ? board_mem_size : 0;
+
+        m_start = Clock::now();
+        m_last = m_start;
+        return ERR_NONE;
+    }
+
+    int BufferMonitor::update()
+    {
+        sint32 avail_samples = 0;
+        int err = DeWeGetParam_i32(m_status.board_no, command(CMD_BUFFER_0_AVAIL_NO_SAMPLE), &avail_samples);
+        if (err > 0)
+        {
+            return err;
+        }
+        return update(avail_samples);
+    }
+
+    int BufferMonitor::update(sint32 avail_samples)
+    {
+        const Clock::time_point now = Clock::now();
+        int err = ERR_NONE;
+
+        if (m_config.board_poll_interval == 0 || m_status.updates % m_config.board_poll_interval == 0)
+        {
+            err = pollBoardMemory();
+        }
+        ++m_status.updates;
+
+        updateRates(avail_samples, now);
+
+        const BufferHealth health = evaluate();
+        if (health != m_health)
+        {
+            const BufferHealth previous = m_health;
+            m_health = health;
+            m_listener.onHealthChanged(m_status, previous, health);
+        }
+        return err;
+    }
+
+    void BufferMonitor::notifyFreed(sint32 samples)
+    {
+        m_freed += samples;
+    }
+
+    int BufferMonitor::pollBoardMemory()
+    {
+        const int board_no = m_status.board_no;
+        int err = DeWeGetParam_i32(board_no, command(CMD_BUFFER_0_AVAIL_FREE_MEM), &m_status.avail_free_mem);
+        if (m_board_memory && err <= 0)
+        {
+            err = DeWeGetParam_i32(board_no, command(CMD_BUFFER_0_FREE_BOARD_MEM_SIZE), &m_status.free_board_mem);
+        }
+        if (m_board_memory && err <= 0)
+        {
+            err = DeWeGetParam_i32(board_no, command(CMD_BUFFER_0_NUM_SAMPLES_IN_BOARD_MEM), &m_status.board_samples);
+        }
+        if (err > 0)
+        {
+            return err;
+        }
+
+        if (m_board_memory)
+        {
+            m_status.board_fill = 1.0 - ratio(m_status.free_board_mem, m_status.board_mem_size);
+            m_status.board_fill_high_water = std::max(m_status.board_fill_high_water, m_status.board_fill);
+        }
+        return ERR_NONE;
+    }
+
+    void BufferMonitor::updateRates(sint32 avail_samples, Clock::time_point now)
+    {
+        const double dt = std::chrono::duration<double>(now - m_last).count();
+        const sint64 produced = static_cast<sint64>(avail_samples) - m_status.avail_samples + m_freed;
+
+        m_status.time = std::chrono::duration<double>(now - m_start).count();
+        m_status.avail_samples = avail_samples;
+        m_status.fill = ratio(avail_samples, m_status.capacity_samples);
+        m_status.fill_high_water = std::max(m_status.fill_high_water, m_status.fill);
+
+        if (m_status.updates == 1)
+        {
+            // baseline only, nothing freed yet
+            m_last = now;
+            m_freed = 0;
+        }
+        else if (dt > 0)
+        {
+            const double alpha = m_status.updates > 2 ? m_config.rate_smoothing : 1.0;
+            m_status.produce_rate += alpha * (produced / dt - m_status.produce_rate);
+            m_status.drain_rate += alpha * (m_freed / dt - m_status.drain_rate);
+            m_last = now;
+            m_freed = 0;
+        }
+
+        const double growth = m_status.produce_rate - m_status.drain_rate;
+        m_status.time_to_full = growth > 0
+            ? (m_status.capacity_samples - avail_samples) / growth
+            : std::numeric_limits<double>::infinity();
+    }
+
+    BufferHealth BufferMonitor::evaluate() const
+    {
+        const double fill = std::max(m_status.fill, m_status.board_fill);
+        const bool warning = m_health != BufferHealth::OK;
+        const bool critical = m_health == BufferHealth::CRITICAL;
+
+        const double critical_fill = critical ? m_config.critical_fill - m_config.hysteresis : m_config.critical_fill;
+        const double critical_time = critical ? m_config.critical_time * TIME_HYSTERESIS : m_config.critical_time;
+        if (fill >= critical_fill || m_status.time_to_full < critical_time)
+        {
+            return BufferHealth::CRITICAL;
+        }
+
+        const double warning_fill = warning ? m_config.warning_fill - m_config.hysteresis : m_config.warning_fill;
+        const double warning_time = warning ? m_config.warning_time * TIME_HYSTERESIS : m_config.warning_time;
+        if (fill >= warning_fill || m_status.time_to_full < warning_time)
+        {
+            return BufferHealth::WARNING;
+        }
+        return BufferHealth::OK;
+    }
+
+    void BufferMonitor::resetHighWater()
+    {
+        m_status.fill_high_water = m_status.fill;
+        m_status.board_fill_high_water = m_status.board_fill;
+    }
+
+    BufferHealth BufferMonitor::getHealth() const
+    {
+        return m_health;
+    }
+
+    const BufferStatus& BufferMonitor::getStatus() const
+    {
+        return m_status;
+    }
+
+} // trion
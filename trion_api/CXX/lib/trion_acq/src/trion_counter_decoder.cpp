@@ -0,0 +1,361 @@
+// Copyright (c) DEWETRON GmbH 2026
+
+#include "trion_counter_decoder.h"
+#include "trion_scan_descriptor.h"
+#include <cstring>
+
+namespace
+{
+    uint32_t maskOf(uint32_t bits)
+    {
+        return bits >= 32 ? 0xFFFFFFFF : ((1u << bits) - 1);
+    }
+
+    void ticksToSeconds(const uint32_t* ticks, std::size_t count, double timebase, double* seconds)
+    {
+        const double factor = 1.0 / timebase;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            seconds[i] = ticks[i] * factor;
+        }
+    }
+
+    void ticksToFrequency(const uint32_t* ticks, std::size_t count, double timebase, double* frequency)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            frequency[i] = ticks[i] ? timebase / ticks[i] : 0.0;
+        }
+    }
+
+    void ratio(const uint32_t* part, const uint32_t* whole, std::size_t count, double* result)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            result[i] = whole[i] ? static_cast<double>(part[i]) / whole[i] : 0.0;
+        }
+    }
+
+} // namespace
+
+
+namespace trion
+{
+    CounterDecoder::CounterDecoder()
+        : m_config()
+        , m_scan_size(0)
+        , m_offset(0)
+        , m_mask(0xFFFFFFFF)
+        , m_sub_offset(0)
+        , m_sub_mask(0xFFFFFFFF)
+    {
+        reset();
+    }
+
+    bool CounterDecoder::usesSubCounter(CounterMode mode)
+    {
+        return mode == CounterMode::SUB_PERIOD
+            || mode == CounterMode::SUB_TWO_PULSE_EDGE_SEP
+            || mode == CounterMode::SUB_FREQUENCY;
+    }
+
+    bool CounterDecoder::configure(const ScanDescriptor& sd, const std::string& name, const CounterConfig& config)
+    {
+        m_scan_size = 0;
+
+        // without sub counter the channel has a single sample
+        const ScanChannel* main = sd.findChannel(name, 0);
+        if (!main)
+        {
+            main = sd.findChannel(name, -1);
+        }
+        const ScanChannel* sub = sd.findChannel(name, 1);
+        if (!main || main->getByteOffset() + 4 > sd.getScanSize()
+            || (usesSubCounter(config.mode) && (!sub || sub->getByteOffset() + 4 > sd.getScanSize())))
+        {
+            return false;
+        }
+
+        configure(sd.getScanSize(), main->getByteOffset(), main->sample_size,
+            sub ? sub->getByteOffset() : 0, sub ? sub->sample_size : 32, config);
+        return true;
+    }
+
+    void CounterDecoder::configure(uint32_t scan_size, uint32_t offset, uint32_t bits,
+        uint32_t sub_offset, uint32_t sub_bits, const CounterConfig& config)
+    {
+        m_config = config;
+        m_scan_size = scan_size;
+        m_offset = offset;
+        m_mask = maskOf(bits);
+        m_sub_offset = sub_offset;
+        m_sub_mask = maskOf(sub_bits);
+        reset();
+    }
+
+    bool CounterDecoder::isConfigured() const
+    {
+        return m_scan_size > 0;
+    }
+
+    const CounterConfig& CounterDecoder::getConfig() const
+    {
+        return m_config;
+    }
+
+    void CounterDecoder::reset()
+    {
+        m_started = false;
+        m_last = 0;
+        m_sub_last = 0;
+        m_total = 0;
+        m_sub_total = 0;
+        m_edge_count = 0;
+        m_edge_ticks = 0;
+        m_since_edge = 0;
+        m_frequency = 0;
+    }
+
+    void CounterDecoder::decode(const void* scans, std::size_t count, const CounterOutput& out)
+    {
+        if (!isConfigured())
+        {
+            return;
+        }
+        decodeBlock(static_cast<const unsigned char*>(scans), count, out, 0);
+    }
+
+    void CounterDecoder::decode(int64_t read_pos, std::size_t count, int64_t buf_end_pos, int64_t buf_size, const CounterOutput& out)
+    {
+        if (!isConfigured())
+        {
+            return;
+        }
+
+        // scans up to the end of the circular buffer
+        const std::size_t first = static_cast<std::size_t>((buf_end_pos - read_pos) / m_scan_size);
+        if (first >= count)
+        {
+            decodeBlock(reinterpret_cast<const unsigned char*>(read_pos), count, out, 0);
+            return;
+        }
+
+        decodeBlock(reinterpret_cast<const unsigned char*>(read_pos), first, out, 0);
+        const int64_t wrapped_pos = read_pos + static_cast<int64_t>(first) * m_scan_size - buf_size;
+        decodeBlock(reinterpret_cast<const unsigned char*>(wrapped_pos), count - first, out, first);
+    }
+
+    void CounterDecoder::gather(const unsigned char* scans, std::size_t count, uint32_t offset, uint32_t mask, uint32_t* raw) const
+    {
+        const unsigned char* pos = scans + offset;
+        for (std::size_t i = 0; i < count; ++i, pos += m_scan_size)
+        {
+            uint32_t value;
+            std::memcpy(&value, pos, sizeof(value));
+            raw[i] = value & mask;
+        }
+    }
+
+    void CounterDecoder::extend(const uint32_t* raw, std::size_t count, uint32_t mask, bool is_signed,
+        uint32_t& last, int64_t& total, int64_t* ext)
+    {
+        // differences first, independent per sample
+        const uint32_t half = mask >> 1;
+        ext[0] = (raw[0] - last) & mask;
+        for (std::size_t i = 1; i < count; ++i)
+        {
+            ext[i] = (raw[i] - raw[i - 1]) & mask;
+        }
+        if (is_signed)
+        {
+            const int64_t range = static_cast<int64_t>(mask) + 1;
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                ext[i] -= ext[i] > half ? range : 0;
+            }
+        }
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            total += ext[i];
+            ext[i] = total;
+        }
+        last = raw[count - 1];
+    }
+
+    void CounterDecoder::decodeBlock(const unsigned char* scans, std::size_t count, const CounterOutput& out, std::size_t out_offset)
+    {
+        if (count == 0)
+        {
+            return;
+        }
+
+        const bool sub = usesSubCounter(m_config.mode);
+        if (m_raw.size() < count)
+        {
+            m_raw.resize(count);
+            m_ext.resize(count);
+        }
+        if (sub && m_sub_raw.size() < count)
+        {
+            m_sub_raw.resize(count);
+            m_sub_ext.resize(count);
+        }
+
+        uint32_t* raw = m_raw.data();
+        uint32_t* sub_raw = m_sub_raw.data();
+        gather(scans, count, m_offset, m_mask, raw);
+        if (sub)
+        {
+            gather(scans, count, m_sub_offset, m_sub_mask, sub_raw);
+        }
+
+        const bool is_signed = m_config.mode == CounterMode::ENCODER;
+        if (!m_started)
+        {
+            // cumulative counters start at their first value
+            m_started = true;
+            m_last = raw[0];
+            m_total = raw[0];
+            if (is_signed && raw[0] > (m_mask >> 1))
+            {
+                m_total -= static_cast<int64_t>(m_mask) + 1;
+            }
+            if (sub)
+            {
+                m_sub_last = sub_raw[0];
+                m_sub_total = sub_raw[0];
+                m_edge_count = m_total;
+                m_edge_ticks = m_sub_total;
+            }
+        }
+
+        const double timebase = m_config.timebase;
+        switch (m_config.mode)
+        {
+        case CounterMode::EVENTS:
+        {
+            const int64_t before = m_total;
+            int64_t* ext = m_ext.data();
+            extend(raw, count, m_mask, false, m_last, m_total, ext);
+            if (out.counts)
+            {
+                std::memcpy(out.counts + out_offset, ext, count * sizeof(int64_t));
+            }
+            if (out.frequency)
+            {
+                double* frequency = out.frequency + out_offset;
+                const double rate = m_config.sample_rate;
+                frequency[0] = (ext[0] - before) * rate;
+                for (std::size_t i = 1; i < count; ++i)
+                {
+                    frequency[i] = (ext[i] - ext[i - 1]) * rate;
+                }
+            }
+            break;
+        }
+
+        case CounterMode::PERIOD:
+            if (out.period)
+            {
+                ticksToSeconds(raw, count, timebase, out.period + out_offset);
+            }
+            if (out.frequency)
+            {
+                ticksToFrequency(raw, count, timebase, out.frequency + out_offset);
+            }
+            break;
+
+        case CounterMode::PULSE_WIDTH:
+        case CounterMode::TWO_PULSE_EDGE_SEP:
+            if (out.time)
+            {
+                ticksToSeconds(raw, count, timebase, out.time + out_offset);
+            }
+            break;
+
+        case CounterMode::SUB_PERIOD:
+        case CounterMode::SUB_TWO_PULSE_EDGE_SEP:
+            if (out.period)
+            {
+                ticksToSeconds(sub_raw, count, timebase, out.period + out_offset);
+            }
+            if (out.frequency)
+            {
+                ticksToFrequency(sub_raw, count, timebase, out.frequency + out_offset);
+            }
+            if (out.duty)
+            {
+                ratio(raw, sub_raw, count, out.duty + out_offset);
+            }
+            if (out.time && m_config.mode == CounterMode::SUB_TWO_PULSE_EDGE_SEP)
+            {
+                ticksToSeconds(raw, count, timebase, out.time + out_offset);
+            }
+            break;
+
+        case CounterMode::SUB_FREQUENCY:
+        {
+            int64_t* edges = m_ext.data();
+            int64_t* ticks = m_sub_ext.data();
+            extend(raw, count, m_mask, false, m_last, m_total, edges);
+            extend(sub_raw, count, m_sub_mask, false, m_sub_last, m_sub_total, ticks);
+            if (out.counts)
+            {
+                std::memcpy(out.counts + out_offset, edges, count * sizeof(int64_t));
+            }
+
+            // edges / time between the last two edge groups, held between
+            // edges and limited by the time since the last edge
+            const double scan_time = m_config.sample_rate > 0 ? 1.0 / m_config.sample_rate : 0.0;
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                ++m_since_edge;
+                if (edges[i] != m_edge_count && ticks[i] != m_edge_ticks)
+                {
+                    m_frequency = (edges[i] - m_edge_count) * timebase / (ticks[i] - m_edge_ticks);
+                    m_edge_count = edges[i];
+                    m_edge_ticks = ticks[i];
+                    m_since_edge = 0;
+                }
+                double frequency = m_frequency;
+                if (scan_time > 0 && m_since_edge * scan_time * frequency > 1.0)
+                {
+                    frequency = 1.0 / (m_since_edge * scan_time);
+                }
+                if (out.frequency)
+                {
+                    out.frequency[out_offset + i] = frequency;
+                }
+                if (out.period)
+                {
+                    out.period[out_offset + i] = frequency > 0 ? 1.0 / frequency : 0.0;
+                }
+            }
+            break;
+        }
+
+        case CounterMode::ENCODER:
+        {
+            int64_t* position = m_ext.data();
+            extend(raw, count, m_mask, true, m_last, m_total, position);
+            if (out.counts)
+            {
+                std::memcpy(out.counts + out_offset, position, count * sizeof(int64_t));
+            }
+            if (out.angle)
+            {
+                const double edges = static_cast<double>(m_config.pulses_per_revolution) * m_config.edges_per_pulse;
+                const double factor = edges > 0 ? 360.0 / edges : 0.0;
+                double* angle = out.angle + out_offset;
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    angle[i] = position[i] * factor;
+                }
+            }
+            break;
+        }
+        }
+    }
+
+} // trion
@@ -0,0 +1,193 @@
+// Copyright (c) DEWETRON GmbH 2026
+
+#include "trion_data_loss_detector.h"
+#include "trion_scan_descriptor.h"
+#include <cstring>
+
+namespace
+{
+    /**
+     * Scans checked per branch free pass
+     */
+    const std::size_t CHUNK_SIZE = 64;
+
+} // namespace
+
+
+namespace trion
+{
+    DataLossDetector::DataLossDetector()
+        : m_scan_size(0)
+        , m_counter_offset(0)
+        , m_counter_mask(0xFFFFFFFF)
+        , m_started(false)
+        , m_expected(0)
+        , m_position(0)
+        , m_lost(0)
+        , m_gaps(0)
+    {
+    }
+
+    bool DataLossDetector::configure(const ScanDescriptor& sd, const std::string& counter_name)
+    {
+        const ScanChannel* channel = sd.findChannel(counter_name);
+        if (!channel || channel->sample_size == 0 || channel->sample_size > 32
+            || channel->getByteOffset() + 4 > sd.getScanSize())
+        {
+            m_scan_size = 0;
+            return false;
+        }
+        configure(sd.getScanSize(), channel->getByteOffset(), channel->sample_size);
+        return true;
+    }
+
+    void DataLossDetector::configure(uint32_t scan_size, uint32_t counter_offset, uint32_t counter_bits)
+    {
+        m_scan_size = scan_size;
+        m_counter_offset = counter_offset;
+        m_counter_mask = counter_bits >= 32 ? 0xFFFFFFFF : ((1u << counter_bits) - 1);
+        reset();
+    }
+
+    bool DataLossDetector::isConfigured() const
+    {
+        return m_scan_size > 0;
+    }
+
+    void DataLossDetector::reset()
+    {
+        m_started = false;
+        m_expected = 0;
+        m_position = 0;
+        m_lost = 0;
+        m_gaps = 0;
+    }
+
+    uint32_t DataLossDetector::counterAt(const unsigned char* scans, std::size_t index) const
+    {
+        uint32_t value;
+        std::memcpy(&value, scans + index * m_scan_size + m_counter_offset, sizeof(value));
+        return value & m_counter_mask;
+    }
+
+    std::size_t DataLossDetector::process(const void* scans, std::size_t count, std::vector<DataLossEvent>& events)
+    {
+        if (!isConfigured())
+        {
+            return 0;
+        }
+        return processBlock(static_cast<const unsigned char*>(scans), count, 0, events);
+    }
+
+    std::size_t DataLossDetector::process(int64_t read_pos, std::size_t count, int64_t buf_end_pos, int64_t buf_size, std::vector<DataLossEvent>& events)
+    {
+        if (!isConfigured())
+        {
+            return 0;
+        }
+
+        // scans up to the end of the circular buffer
+        const std::size_t first = static_cast<std::size_t>((buf_end_pos - read_pos) / m_scan_size);
+        if (first >= count)
+        {
+            return processBlock(reinterpret_cast<const unsigned char*>(read_pos), count, 0, events);
+        }
+
+        std::size_t added = processBlock(reinterpret_cast<const unsigned char*>(read_pos), first, 0, events);
+        const int64_t wrapped_pos = read_pos + static_cast<int64_t>(first) * m_scan_size - buf_size;
+        added += processBlock(reinterpret_cast<const unsigned char*>(wrapped_pos), count - first, first, events);
+        return added;
+    }
+
+    std::size_t DataLossDetector::processBlock(const unsigned char* scans, std::size_t count,
+        std::size_t block_offset, std::vector<DataLossEvent>& events)
+    {
+        if (count == 0)
+        {
+            return 0;
+        }
+
+        if (!m_started)
+        {
+            m_started = true;
+            m_expected = counterAt(scans, 0);
+        }
+
+        std::size_t added = 0;
+        for (std::size_t begin = 0; begin < count; begin += CHUNK_SIZE)
+        {
+            const std::size_t end = (count - begin < CHUNK_SIZE) ? count : begin + CHUNK_SIZE;
+
+            // branch free: any difference to the expected sequence sets bits
+            uint32_t diff = 0;
+            for (std::size_t n = begin; n < end; ++n)
+            {
+                diff |= (counterAt(scans, n) - (m_expected + static_cast<uint32_t>(n - begin))) & m_counter_mask;
+            }
+
+            if (diff == 0)
+            {
+                const uint32_t chunk = static_cast<uint32_t>(end - begin);
+                m_expected = (m_expected + chunk) & m_counter_mask;
+                m_position += chunk;
+            }
+            else
+            {
+                added += searchChunk(scans, begin, end, block_offset, events);
+            }
+        }
+        return added;
+    }
+
+    std::size_t DataLossDetector::searchChunk(const unsigned char* scans, std::size_t begin, std::size_t end,
+        std::size_t block_offset, std::vector<DataLossEvent>& events)
+    {
+        std::size_t added = 0;
+        for (std::size_t n = begin; n < end; ++n)
+        {
+            const uint32_t value = counterAt(scans, n);
+            const uint32_t lost = (value - m_expected) & m_counter_mask;
+            if (lost != 0)
+            {
+                DataLossEvent event;
+                event.block_index = block_offset + n;
+                event.position = m_position;
+                if (lost > (m_counter_mask >> 1))
+                {
+                    // backwards: a new time base starts
+                    event.kind = DataLossEvent::RESYNC;
+                    event.length = 0;
+                }
+                else
+                {
+                    event.kind = DataLossEvent::GAP;
+                    event.length = lost;
+                    m_position += lost;
+                    m_lost += lost;
+                    ++m_gaps;
+                }
+                events.push_back(event);
+                ++added;
+            }
+            m_expected = (value + 1) & m_counter_mask;
+            ++m_position;
+        }
+        return added;
+    }
+
+    uint64_t DataLossDetector::getPosition() const
+    {
+        return m_position;
+    }
+
+    uint64_t DataLossDetector::getLostSamples() const
+    {
+        return m_lost;
+    }
+
+    uint64_t DataLossDetector::getGapCount() const
+    {
+        return m_gaps;
+    }
+
+} // trion
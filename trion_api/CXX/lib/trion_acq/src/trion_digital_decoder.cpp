@@ -0,0 +1,224 @@
+// Copyright (c) DEWETRON GmbH 2026
+
+#include "trion_digital_decoder.h"
+#include "trion_scan_descriptor.h"
+#include <algorithm>
+#include <cstring>
+#ifdef _MSC_VER
+#  include <intrin.h>
+#endif
+
+namespace
+{
+    /**
+     * Words checked per branch free pass
+     */
+    const std::size_t CHUNK_SIZE = 64;
+
+    inline unsigned int countTrailingZeros(uint32_t value)
+    {
+#ifdef _MSC_VER
+        unsigned long index;
+        _BitScanForward(&index, value);
+        return index;
+#else
+        return __builtin_ctz(value);
+#endif
+    }
+
+    /**
+     * Transpose the 8x8 bit matrix with element (row, col) at bit 8 * row + col
+     */
+    inline uint64_t transpose8(uint64_t x)
+    {
+        uint64_t t;
+        t = (x ^ (x >> 7)) & UINT64_C(0x00AA00AA00AA00AA);
+        x = x ^ t ^ (t << 7);
+        t = (x ^ (x >> 14)) & UINT64_C(0x0000CCCC0000CCCC);
+        x = x ^ t ^ (t << 14);
+        t = (x ^ (x >> 28)) & UINT64_C(0x00000000F0F0F0F0);
+        x = x ^ t ^ (t << 28);
+        return x;
+    }
+
+} // namespace
+
+
+namespace trion
+{
+    DigitalDecoder::DigitalDecoder()
+        : m_scan_size(0)
+        , m_offset(0)
+        , m_lines(0)
+        , m_bytes(0)
+        , m_mask(0)
+        , m_started(false)
+        , m_last(0)
+    {
+    }
+
+    bool DigitalDecoder::configure(const ScanDescriptor& sd, const std::string& name)
+    {
+        const ScanChannel* channel = sd.findChannel(name);
+        if (!channel || channel->sample_size == 0 || channel->sample_size > 32
+            || channel->getByteOffset() + (channel->sample_size + 7) / 8 > sd.getScanSize())
+        {
+            m_scan_size = 0;
+            return false;
+        }
+        configure(sd.getScanSize(), channel->getByteOffset(), channel->sample_size);
+        return true;
+    }
+
+    void DigitalDecoder::configure(uint32_t scan_size, uint32_t offset, uint32_t lines)
+    {
+        m_scan_size = scan_size;
+        m_offset = offset;
+        m_lines = std::min<uint32_t>(lines, 32);
+        m_bytes = (m_lines + 7) / 8;
+        m_mask = m_lines >= 32 ? 0xFFFFFFFF : ((1u << m_lines) - 1);
+        reset();
+    }
+
+    bool DigitalDecoder::isConfigured() const
+    {
+        return m_scan_size > 0;
+    }
+
+    uint32_t DigitalDecoder::getLineCount() const
+    {
+        return m_lines;
+    }
+
+    void DigitalDecoder::reset()
+    {
+        m_started = false;
+        m_last = 0;
+    }
+
+    void DigitalDecoder::gather(const void* scans, std::size_t count, uint32_t* words) const
+    {
+        if (!isConfigured())
+        {
+            return;
+        }
+        gatherBlock(static_cast<const unsigned char*>(scans), count, words);
+    }
+
+    void DigitalDecoder::gather(int64_t read_pos, std::size_t count, int64_t buf_end_pos, int64_t buf_size, uint32_t* words) const
+    {
+        if (!isConfigured())
+        {
+            return;
+        }
+
+        // scans up to the end of the circular buffer
+        const std::size_t first = static_cast<std::size_t>((buf_end_pos - read_pos) / m_scan_size);
+        if (first >= count)
+        {
+            gatherBlock(reinterpret_cast<const unsigned char*>(read_pos), count, words);
+            return;
+        }
+
+        gatherBlock(reinterpret_cast<const unsigned char*>(read_pos), first, words);
+        const int64_t wrapped_pos = read_pos + static_cast<int64_t>(first) * m_scan_size - buf_size;
+        gatherBlock(reinterpret_cast<const unsigned char*>(wrapped_pos), count - first, words + first);
+    }
+
+    void DigitalDecoder::gatherBlock(const unsigned char* scans, std::size_t count, uint32_t* words) const
+    {
+        // only the bytes of the sample, it may end the scan
+        const unsigned char* pos = scans + m_offset;
+        for (std::size_t i = 0; i < count; ++i, pos += m_scan_size)
+        {
+            uint32_t value = 0;
+            std::memcpy(&value, pos, m_bytes);
+            words[i] = value & m_mask;
+        }
+    }
+
+    std::size_t DigitalDecoder::extractEdges(const uint32_t* words, std::size_t count, std::vector<DigitalEdge>& edges)
+    {
+        if (count == 0)
+        {
+            return 0;
+        }
+
+        uint32_t prev = m_started ? m_last : words[0];
+        m_started = true;
+
+        std::size_t added = 0;
+        for (std::size_t begin = 0; begin < count; begin += CHUNK_SIZE)
+        {
+            const std::size_t end = (count - begin < CHUNK_SIZE) ? count : begin + CHUNK_SIZE;
+
+            // branch free: any change within the chunk sets bits
+            uint32_t changes = words[begin] ^ prev;
+            for (std::size_t n = begin + 1; n < end; ++n)
+            {
+                changes |= words[n] ^ words[n - 1];
+            }
+
+            if (changes != 0)
+            {
+                for (std::size_t n = begin; n < end; ++n)
+                {
+                    const uint32_t word = words[n];
+                    uint32_t toggled = word ^ prev;
+                    while (toggled != 0)
+                    {
+                        const unsigned int line = countTrailingZeros(toggled);
+                        edges.push_back(DigitalEdge{ n, static_cast<uint8_t>(line), ((word >> line) & 1) != 0 });
+                        ++added;
+                        toggled &= toggled - 1;
+                    }
+                    prev = word;
+                }
+            }
+            prev = words[end - 1];
+        }
+
+        m_last = prev;
+        return added;
+    }
+
+    void DigitalDecoder::unpackBytes(const uint32_t* words, std::size_t count, uint32_t line_count, uint8_t* const* lines)
+    {
+        for (uint32_t line = 0; line < line_count; ++line)
+        {
+            uint8_t* out = lines[line];
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                out[i] = static_cast<uint8_t>((words[i] >> line) & 1);
+            }
+        }
+    }
+
+    void DigitalDecoder::unpackPlanes(const uint32_t* words, std::size_t count, uint32_t line_count, uint8_t* const* planes)
+    {
+        const uint32_t lanes = (line_count + 7) / 8;
+        for (std::size_t group = 0; group * 8 < count; ++group)
+        {
+            const std::size_t first = group * 8;
+            const std::size_t samples = std::min<std::size_t>(8, count - first);
+
+            for (uint32_t lane = 0; lane < lanes; ++lane)
+            {
+                // row = sample, column = line of this byte lane
+                uint64_t matrix = 0;
+                for (std::size_t i = 0; i < samples; ++i)
+                {
+                    matrix |= static_cast<uint64_t>((words[first + i] >> (lane * 8)) & 0xFF) << (i * 8);
+                }
+                matrix = transpose8(matrix);
+
+                const uint32_t lines = std::min<uint32_t>(8, line_count - lane * 8);
+                for (uint32_t j = 0; j < lines; ++j)
+                {
+                    planes[lane * 8 + j][group] = static_cast<uint8_t>(matrix >> (j * 8));
+                }
+            }
+        }
+    }
+
+} // trion
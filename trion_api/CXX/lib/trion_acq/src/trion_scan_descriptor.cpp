@@ -0,0 +1,134 @@
+// Copyright (c) DEWETRON GmbH 2026
+
+#include "trion_scan_descriptor.h"
+#include "dewepxi_apicxx.h"
+#include <pugixml.hpp>
+#include <cctype>
+
+namespace
+{
+    const char SCAN_DESCRIPTOR_COMMAND[] = "ScanDescriptor_V3";
+
+    bool equalsNoCase(const std::string& a, const std::string& b)
+    {
+        if (a.size() != b.size())
+        {
+            return false;
+        }
+        for (std::size_t n = 0; n < a.size(); ++n)
+        {
+            if (std::tolower(static_cast<unsigned char>(a[n])) != std::tolower(static_cast<unsigned char>(b[n])))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+} // namespace
+
+
+namespace trion
+{
+    ScanDescriptor::ScanDescriptor()
+        : m_scan_size(0)
+    {
+    }
+
+    int ScanDescriptor::read(int board_no)
+    {
+        const std::string board = "BoardID" + std::to_string(board_no);
+        size_t length = 0;
+        int err = DeWeGetParamStruct_str_buf(board.c_str(), SCAN_DESCRIPTOR_COMMAND, m_buffer, length);
+        if (err != ERR_NONE)
+        {
+            return err;
+        }
+        return parse(m_buffer.data(), length) ? ERR_NONE : ERR_INVALID_VALUE;
+    }
+
+    bool ScanDescriptor::parse(const std::string& xml)
+    {
+        return parse(xml.data(), xml.size());
+    }
+
+    bool ScanDescriptor::parse(const char* xml, std::size_t length)
+    {
+        clear();
+
+        pugi::xml_document doc;
+        if (!doc.load_buffer(xml, length))
+        {
+            return false;
+        }
+
+        pugi::xml_node description = doc.select_node("ScanDescriptor/*/ScanDescription").node();
+        if (!description || description.attribute("version").as_int() != 3)
+        {
+            return false;
+        }
+
+        // scan_size and offsets are in bit ("unit")
+        m_scan_size = description.attribute("scan_size").as_uint() / 8;
+
+        for (pugi::xml_node channel = description.child("Channel"); channel; channel = channel.next_sibling("Channel"))
+        {
+            // counters list one Sample per sub channel
+            for (pugi::xml_node sample = channel.child("Sample"); sample; sample = sample.next_sibling("Sample"))
+            {
+                pugi::xml_attribute sub_channel = sample.attribute("subChannel");
+
+                ScanChannel entry;
+                entry.name = channel.attribute("name").as_string();
+                entry.type = channel.attribute("type").as_string();
+                entry.index = channel.attribute("index").as_uint();
+                entry.sample_offset = sample.attribute("offset").as_uint();
+                entry.sample_size = sample.attribute("size").as_uint();
+                entry.sub_channel = sub_channel ? sub_channel.as_int() : -1;
+                m_channels.push_back(entry);
+            }
+        }
+        return true;
+    }
+
+    void ScanDescriptor::clear()
+    {
+        m_scan_size = 0;
+        m_channels.clear();
+    }
+
+    uint32_t ScanDescriptor::getScanSize() const
+    {
+        return m_scan_size;
+    }
+
+    const std::vector<ScanChannel>& ScanDescriptor::getChannels() const
+    {
+        return m_channels;
+    }
+
+    const ScanChannel* ScanDescriptor::findChannel(const std::string& name) const
+    {
+        for (const auto& channel : m_channels)
+        {
+            if (equalsNoCase(channel.name, name))
+            {
+                return &channel;
+            }
+        }
+        return nullptr;
+    }
+
+    const ScanChannel* ScanDescriptor::findChannel(const std::string& name, int sub_channel) const
+    {
+        for (const auto& channel : m_channels)
+        {
+            if (channel.sub_channel == sub_channel && equalsNoCase(channel.name, name))
+            {
+                return &channel;
+            }
+        }
+        return nullptr;
+    }
+
+} // trion
@@ -0,0 +1,316 @@
+// Copyright (c) DEWETRON GmbH 2026
+
+#include "trion_teds_manager.h"
+#include "dewepxi_apicxx.h"
+#include "dewepxi_hash.h"
+#include <pugixml.hpp>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+
+namespace
+{
+    std::string channelTarget(int board_no, int channel)
+    {
+        return "BoardID" + std::to_string(board_no) + "/AI" + std::to_string(channel);
+    }
+
+    /**
+     * Property value as text or Value attribute
+     */
+    bool propertyValue(const pugi::xml_node& property, double& value)
+    {
+        const char* text = property.child_value();
+        if (!text || !*text)
+        {
+            text = property.attribute("Value").value();
+        }
+        char* end = nullptr;
+        value = std::strtod(text, &end);
+        return end != text;
+    }
+
+    bool readFile(const std::string& path, std::string& content)
+    {
+        FILE* file = std::fopen(path.c_str(), "rb");
+        if (!file)
+        {
+            return false;
+        }
+        content.clear();
+        char chunk[4096];
+        std::size_t count;
+        while ((count = std::fread(chunk, 1, sizeof(chunk), file)) > 0)
+        {
+            content.append(chunk, count);
+        }
+        const bool ok = !std::ferror(file);
+        std::fclose(file);
+        return ok;
+    }
+
+} // namespace
+
+
+namespace trion
+{
+    TedsManager::TedsManager(const std::string& cache_dir)
+        : m_cache_dir(cache_dir)
+    {
+    }
+
+    int TedsManager::readAll(const std::vector<int>& boards)
+    {
+        std::vector<std::vector<TedsChannel>> results(boards.size());
+        std::vector<int> errors(boards.size(), ERR_NONE);
+
+        // one worker per board, the boards do not share a 1-Wire bus
+        std::vector<std::thread> workers;
+        workers.reserve(boards.size());
+        for (std::size_t n = 0; n < boards.size(); ++n)
+        {
+            workers.emplace_back([this, &boards, &results, &errors, n]()
+            {
+                errors[n] = readBoard(boards[n], results[n]);
+            });
+        }
+        for (auto& worker : workers)
+        {
+            worker.join();
+        }
+
+        m_channels.clear();
+        int err = ERR_NONE;
+        for (std::size_t n = 0; n < boards.size(); ++n)
+        {
+            m_channels.insert(m_channels.end(), results[n].begin(), results[n].end());
+            if (err == ERR_NONE && errors[n] > 0)
+            {
+                err = errors[n];
+            }
+        }
+        std::stable_sort(m_channels.begin(), m_channels.end(), [](const TedsChannel& a, const TedsChannel& b)
+        {
+            return a.board_no != b.board_no ? a.board_no < b.board_no : a.channel < b.channel;
+        });
+        return err;
+    }
+
+    int TedsManager::readBoard(int board_no, std::vector<TedsChannel>& channels)
+    {
+        std::string value;
+        const std::string target = "BoardID" + std::to_string(board_no) + "/AI";
+        int err = DeWeGetParamStruct_str_s(target, "Channels", value);
+        if (err > 0)
+        {
+            return err;
+        }
+
+        const int count = std::atoi(value.c_str());
+        for (int channel = 0; channel < count; ++channel)
+        {
+            channels.push_back(readChannel(board_no, channel));
+        }
+        return ERR_NONE;
+    }
+
+    int TedsManager::probe(int board_no, int channel, uint64_t& fingerprint)
+    {
+        fingerprint = 0;
+        const std::string target = channelTarget(board_no, channel);
+
+        std::string rom_code;
+        int err = DeWeGetParamStruct_str_s(target, "TedsType", rom_code);
+        if (err != ERR_NONE)
+        {
+            return err;
+        }
+        std::string page;
+        err = DeWeGetParamStruct_str_s(target, "TedsMem1", page);
+        if (err != ERR_NONE)
+        {
+            return err;
+        }
+
+        uint64_t hash = fnv1a(rom_code.data(), rom_code.size());
+        hash = fnv1a(page.data(), page.size(), hash ^ 0xFF);
+        fingerprint = hash != 0 ? hash : 1;
+        return ERR_NONE;
+    }
+
+    TedsChannel TedsManager::readChannel(int board_no, int channel)
+    {
+        TedsChannel result;
+        result.board_no = board_no;
+        result.channel = channel;
+
+        // a chain with several devices fails the probe and is always read
+        int err = probe(board_no, channel, result.fingerprint);
+        if (err == ERROR_TEDS_NOT_FOUND || err == WARNING_TEDS_NOT_FOUND
+            || err == ERROR_TEDS_NOT_SUPPORTED || err == WARNING_TEDS_NOT_SUPPORTED)
+        {
+            result.error = err;
+            return result;
+        }
+
+        if (result.fingerprint != 0 && lookup(result.fingerprint, result.xml))
+        {
+            result.cached = true;
+        }
+        else
+        {
+            err = DeWeGetParamStruct_str_s(channelTarget(board_no, channel), "TedsReadExChain", result.xml);
+            if (err > 0)
+            {
+                result.error = err;
+                return result;
+            }
+            if (result.fingerprint != 0)
+            {
+                store(result.fingerprint, result.xml);
+            }
+        }
+
+        decode(result.xml, result.serial, result.scaling);
+        return result;
+    }
+
+    const std::vector<TedsChannel>& TedsManager::getChannels() const
+    {
+        return m_channels;
+    }
+
+    const TedsChannel* TedsManager::findChannel(int board_no, int channel) const
+    {
+        for (const auto& entry : m_channels)
+        {
+            if (entry.board_no == board_no && entry.channel == channel)
+            {
+                return &entry;
+            }
+        }
+        return nullptr;
+    }
+
+    std::vector<TedsScaling> TedsManager::getScalingTable(int board_no) const
+    {
+        std::vector<TedsScaling> table;
+        for (const auto& entry : m_channels)
+        {
+            if (entry.board_no != board_no)
+            {
+                continue;
+            }
+            if (table.size() <= static_cast<std::size_t>(entry.channel))
+            {
+                table.resize(entry.channel + 1);
+            }
+            table[entry.channel] = entry.scaling;
+        }
+        return table;
+    }
+
+    bool TedsManager::decode(const std::string& xml, std::string& serial, TedsScaling& scaling)
+    {
+        serial.clear();
+        scaling = TedsScaling();
+
+        pugi::xml_document doc;
+        if (xml.empty() || !doc.load_buffer(xml.data(), xml.size()))
+        {
+            return false;
+        }
+
+        // a chain has one TEDSInfo per device, the first calibrated one wins
+        for (const pugi::xpath_node& node : doc.select_nodes("//TEDSInfo"))
+        {
+            const pugi::xml_node info = node.node();
+            if (serial.empty())
+            {
+                serial = info.attribute("Serial").value();
+            }
+
+            double min_phys = 0, max_phys = 0, min_elec = 0, max_elec = 0;
+            const bool found =
+                propertyValue(info.select_node(".//Property[@Name='MinPhysVal']").node(), min_phys)
+                && propertyValue(info.select_node(".//Property[@Name='MaxPhysVal']").node(), max_phys)
+                && propertyValue(info.select_node(".//Property[@Name='MinElecVal']").node(), min_elec)
+                && propertyValue(info.select_node(".//Property[@Name='MaxElecVal']").node(), max_elec);
+            if (found && max_elec != min_elec)
+            {
+                serial = info.attribute("Serial").value();
+                scaling.valid = true;
+                scaling.gain = (max_phys - min_phys) / (max_elec - min_elec);
+                scaling.offset = min_phys - scaling.gain * min_elec;
+                break;
+            }
+        }
+        return true;
+    }
+
+    std::size_t TedsManager::getCacheSize() const
+    {
+        std::lock_guard<std::mutex> lock(m_cache_mutex);
+        return m_cache.size();
+    }
+
+    void TedsManager::clearCache()
+    {
+        std::lock_guard<std::mutex> lock(m_cache_mutex);
+        m_cache.clear();
+    }
+
+    std::string TedsManager::getCachePath(uint64_t fingerprint) const
+    {
+        char name[32];
+        std::snprintf(name, sizeof(name), "teds_%016llx.xml", static_cast<unsigned long long>(fingerprint));
+        return m_cache_dir + "/" + name;
+    }
+
+    bool TedsManager::lookup(uint64_t fingerprint, std::string& xml)
+    {
+        std::lock_guard<std::mutex> lock(m_cache_mutex);
+        auto it = m_cache.find(fingerprint);
+        if (it != m_cache.end())
+        {
+            xml = it->second;
+            return true;
+        }
+
+        if (m_cache_dir.empty() || !readFile(getCachePath(fingerprint), xml) || xml.empty())
+        {
+            return false;
+        }
+        m_cache[fingerprint] = xml;
+        return true;
+    }
+
+    void TedsManager::store(uint64_t fingerprint, const std::string& xml)
+    {
+        std::lock_guard<std::mutex> lock(m_cache_mutex);
+        m_cache[fingerprint] = xml;
+        if (m_cache_dir.empty())
+        {
+            return;
+        }
+
+        // write aside and rename, a reader never sees a partial file
+        const std::string path = getCachePath(fingerprint);
+        const std::string temp = path + ".tmp";
+        FILE* file = std::fopen(temp.c_str(), "wb");
+        if (!file)
+        {
+            return;
+        }
+        const bool ok = std::fwrite(xml.data(), 1, xml.size(), file) == xml.size();
+        if (std::fclose(file) != 0 || !ok)
+        {
+            std::remove(temp.c_str());
+            return;
+        }
+        std::remove(path.c_str());
+        std::rename(temp.c_str(), path.c_str());
+    }
+
+} // trion
@@ -0,0 +1,395 @@
+// Copyright (c) DEWETRON GmbH 2026
+
+#include "trion_temperature_linearizer.h"
+#include <algorithm>
+#include <mutex>
+
+namespace
+{
+    /**
+     * Table segments, voltage and temperature tables
+     */
+    const std::size_t THERMOCOUPLE_SEGMENTS = 2048;
+    const std::size_t RTD_SEGMENTS = 1024;
+
+    const double RTD_MIN_TEMPERATURE = -200.0;
+    const double RTD_MAX_TEMPERATURE = 850.0;
+
+    /**
+     * NIST ITS-90 reference function, E = sum c[i] * t^i on t <= t_max
+     */
+    struct ReferenceRange
+    {
+        double t_max;
+        const double* c;
+        std::size_t count;
+    };
+
+    struct ReferenceFunction
+    {
+        double t_min;               //!< range of the NIST inverse functions
+        double t_max;
+        ReferenceRange ranges[3];
+        std::size_t range_count;
+        bool exponential;           //!< type K above 0 degC
+    };
+
+    const double B_0[] = { 0.0, -0.246508183460E-03, 0.590404211710E-05, -0.132579316360E-08,
+        0.156682919010E-11, -0.169445292400E-14, 0.629903470940E-18 };
+    const double B_1[] = { -0.389381686210E+01, 0.285717474700E-01, -0.848851047850E-04, 0.157852801640E-06,
+        -0.168353448640E-09, 0.111097940130E-12, -0.445154310330E-16, 0.989756408210E-20, -0.937913302890E-24 };
+
+    const double E_0[] = { 0.0, 0.586655087080E-01, 0.454109771240E-04, -0.779980486860E-06,
+        -0.258001608430E-07, -0.594525830570E-09, -0.932140586670E-11, -0.102876055340E-12,
+        -0.803701236210E-15, -0.439794973910E-17, -0.164147763550E-19, -0.396736195160E-22,
+        -0.558273287210E-25, -0.346578420130E-28 };
+    const double E_1[] = { 0.0, 0.586655087100E-01, 0.450322755820E-04, 0.289084072120E-07,
+        -0.330568966520E-09, 0.650244032700E-12, -0.191974955040E-15, -0.125366004970E-17,
+        0.214892175690E-20, -0.143880417820E-23, 0.359608994810E-27 };
+
+    const double J_0[] = { 0.0, 0.503811878150E-01, 0.304758369300E-04, -0.856810657200E-07,
+        0.132281952950E-09, -0.170529583370E-12, 0.209480906970E-15, -0.125383953360E-18,
+        0.156317256970E-22 };
+    const double J_1[] = { 0.296456256810E+03, -0.149761277860E+01, 0.317871039240E-02,
+        -0.318476867010E-05, 0.157208190040E-08, -0.306913690560E-12 };
+
+    const double K_0[] = { 0.0, 0.394501280250E-01, 0.236223735980E-04, -0.328589067840E-06,
+        -0.499048287770E-08, -0.675090591730E-10, -0.574103274280E-12, -0.310888728940E-14,
+        -0.104516093650E-16, -0.198892668780E-19, -0.163226974860E-22 };
+    const double K_1[] = { -0.176004136860E-01, 0.389212049750E-01, 0.185587700320E-04,
+        -0.994575928740E-07, 0.318409457190E-09, -0.560728448890E-12, 0.560750590590E-15,
+        -0.320207200030E-18, 0.971511471520E-22, -0.121047212750E-25 };
+    const double K_A0 = 0.118597600000E+00;
+    const double K_A1 = -0.118343200000E-03;
+    const double K_A2 = 0.126968600000E+03;
+
+    const double N_0[] = { 0.0, 0.261591059620E-01, 0.109574842280E-04, -0.938411115540E-07,
+        -0.464120397590E-10, -0.263033577160E-11, -0.226534380030E-13, -0.760893007910E-16,
+        -0.934196678350E-19 };
+    const double N_1[] = { 0.0, 0.259293946010E-01, 0.157101418800E-04, 0.438256272370E-07,
+        -0.252611697940E-09, 0.643118193390E-12, -0.100634715190E-14, 0.997453389920E-18,
+        -0.608632456070E-21, 0.208492293390E-24, -0.306821961510E-28 };
+
+    const double R_0[] = { 0.0, 0.528961729765E-02, 0.139166589782E-04, -0.238855693017E-07,
+        0.356916001063E-10, -0.462347666298E-13, 0.500777441034E-16, -0.373105886191E-19,
+        0.157716482367E-22, -0.281038625251E-26 };
+    const double R_1[] = { 0.295157925316E+01, -0.252061251332E-02, 0.159564501865E-04,
+        -0.764085947576E-08, 0.205305291024E-11, -0.293359668173E-15 };
+    const double R_2[] = { 0.152232118209E+03, -0.268819888545E+00, 0.171280280471E-03,
+        -0.345895706453E-07, -0.934633971046E-14 };
+
+    const double S_0[] = { 0.0, 0.540313308631E-02, 0.125934289740E-04, -0.232477968689E-07,
+        0.322028823036E-10, -0.331465196389E-13, 0.255744251786E-16, -0.125068871393E-19,
+        0.271443176145E-23 };
+    const double S_1[] = { 0.132900444085E+01, 0.334509311344E-02, 0.654805192818E-05,
+        -0.164856259209E-08, 0.129989605174E-13 };
+    const double S_2[] = { 0.146628232636E+03, -0.258430516752E+00, 0.163693574641E-03,
+        -0.330439046987E-07, -0.943223690612E-14 };
+
+    const double T_0[] = { 0.0, 0.387481063640E-01, 0.441944343470E-04, 0.118443231050E-06,
+        0.200329735540E-07, 0.901380195590E-09, 0.226511565930E-10, 0.360711542050E-12,
+        0.384939398830E-14, 0.282135219250E-16, 0.142515947790E-18, 0.487686622860E-21,
+        0.107955392700E-23, 0.139450270620E-26, 0.797951539270E-30 };
+    const double T_1[] = { 0.0, 0.387481063640E-01, 0.332922278800E-04, 0.206182434040E-06,
+        -0.218822568460E-08, 0.109968809280E-10, -0.308157587720E-13, 0.454791352900E-16,
+        -0.275129016730E-19 };
+
+#define REFERENCE_RANGE(t_max, c) { t_max, c, sizeof(c) / sizeof(c[0]) }
+
+    const ReferenceFunction REFERENCE_FUNCTIONS[] =
+    {
+        { 250.0, 1820.0, { REFERENCE_RANGE(630.615, B_0), REFERENCE_RANGE(1820.0, B_1) }, 2, false },
+        { -200.0, 1000.0, { REFERENCE_RANGE(0.0, E_0), REFERENCE_RANGE(1000.0, E_1) }, 2, false },
+        { -210.0, 1200.0, { REFERENCE_RANGE(760.0, J_0), REFERENCE_RANGE(1200.0, J_1) }, 2, false },
+        { -200.0, 1372.0, { REFERENCE_RANGE(0.0, K_0), REFERENCE_RANGE(1372.0, K_1) }, 2, true },
+        { -200.0, 1300.0, { REFERENCE_RANGE(0.0, N_0), REFERENCE_RANGE(1300.0, N_1) }, 2, false },
+        { -50.0, 1768.1, { REFERENCE_RANGE(1064.18, R_0), REFERENCE_RANGE(1664.5, R_1), REFERENCE_RANGE(1768.1, R_2) }, 3, false },
+        { -50.0, 1768.1, { REFERENCE_RANGE(1064.18, S_0), REFERENCE_RANGE(1664.5, S_1), REFERENCE_RANGE(1768.1, S_2) }, 3, false },
+        { -200.0, 400.0, { REFERENCE_RANGE(0.0, T_0), REFERENCE_RANGE(400.0, T_1) }, 2, false },
+    };
+
+#undef REFERENCE_RANGE
+
+    const ReferenceFunction& referenceFunction(trion::ThermocoupleType type)
+    {
+        return REFERENCE_FUNCTIONS[static_cast<int>(type)];
+    }
+
+    const ReferenceRange& referenceRange(const ReferenceFunction& function, double t)
+    {
+        for (std::size_t n = 0; n + 1 < function.range_count; ++n)
+        {
+            if (t <= function.ranges[n].t_max)
+            {
+                return function.ranges[n];
+            }
+        }
+        return function.ranges[function.range_count - 1];
+    }
+
+    double evaluateVoltage(const ReferenceFunction& function, double t)
+    {
+        const ReferenceRange& range = referenceRange(function, t);
+        double e = 0;
+        for (std::size_t i = range.count; i-- > 0;)
+        {
+            e = e * t + range.c[i];
+        }
+        if (function.exponential && t > 0)
+        {
+            const double d = t - K_A2;
+            e += K_A0 * std::exp(K_A1 * d * d);
+        }
+        return e;
+    }
+
+    double evaluateSlope(const ReferenceFunction& function, double t)
+    {
+        const ReferenceRange& range = referenceRange(function, t);
+        double de = 0;
+        for (std::size_t i = range.count; i-- > 1;)
+        {
+            de = de * t + i * range.c[i];
+        }
+        if (function.exponential && t > 0)
+        {
+            const double d = t - K_A2;
+            de += 2 * K_A0 * K_A1 * d * std::exp(K_A1 * d * d);
+        }
+        return de;
+    }
+
+    /**
+     * Inverse of a monotonically increasing function on [x_min, x_max],
+     * Newton with bisection as fallback.
+     */
+    double invert(const std::function<double(double)>& f, const std::function<double(double)>& df,
+        double y, double x_min, double x_max)
+    {
+        double low = x_min;
+        double high = x_max;
+        double x = 0.5 * (low + high);
+        for (int iteration = 0; iteration < 100; ++iteration)
+        {
+            const double residual = f(x) - y;
+            if (residual > 0)
+            {
+                high = x;
+            }
+            else
+            {
+                low = x;
+            }
+
+            const double slope = df(x);
+            double next = slope > 0 ? x - residual / slope : low - 1;
+            if (!(next > low && next < high))
+            {
+                next = 0.5 * (low + high);
+            }
+            if (std::fabs(next - x) < 1e-12 * (1 + std::fabs(x)))
+            {
+                return next;
+            }
+            x = next;
+        }
+        return x;
+    }
+
+} // namespace
+
+
+namespace trion
+{
+    PiecewiseCubic::PiecewiseCubic()
+        : m_x_min(0)
+        , m_x_max(0)
+        , m_scale(0)
+        , m_last(0)
+    {
+    }
+
+    void PiecewiseCubic::build(const std::function<double(double)>& f, const std::function<double(double)>& df,
+        double x_min, double x_max, std::size_t segments)
+    {
+        segments = std::max<std::size_t>(segments, 1);
+        const double step = (x_max - x_min) / segments;
+        m_x_min = x_min;
+        m_x_max = x_max;
+        m_scale = 1.0 / step;
+        m_last = static_cast<double>(segments - 1);
+
+        // Hermite form in t = 0..1, slopes scaled to the segment
+        m_coefficients.resize(4 * segments);
+        double y0 = f(x_min);
+        double d0 = df(x_min) * step;
+        for (std::size_t n = 0; n < segments; ++n)
+        {
+            const double x1 = x_min + (n + 1) * step;
+            const double y1 = f(x1);
+            const double d1 = df(x1) * step;
+            double* c = m_coefficients.data() + 4 * n;
+            c[0] = y0;
+            c[1] = d0;
+            c[2] = 3 * (y1 - y0) - 2 * d0 - d1;
+            c[3] = 2 * (y0 - y1) + d0 + d1;
+            y0 = y1;
+            d0 = d1;
+        }
+    }
+
+    bool PiecewiseCubic::empty() const
+    {
+        return m_coefficients.empty();
+    }
+
+    double PiecewiseCubic::getMin() const
+    {
+        return m_x_min;
+    }
+
+    double PiecewiseCubic::getMax() const
+    {
+        return m_x_max;
+    }
+
+    void PiecewiseCubic::evaluate(const float* x, std::size_t count, float* y) const
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            y[i] = static_cast<float>((*this)(x[i]));
+        }
+    }
+
+
+    ThermocoupleLinearizer::ThermocoupleLinearizer(ThermocoupleType type)
+        : m_type(type)
+        , m_tables(getTables(type))
+    {
+    }
+
+    std::shared_ptr<const ThermocoupleLinearizer::Tables> ThermocoupleLinearizer::getTables(ThermocoupleType type)
+    {
+        static std::mutex mutex;
+        static std::shared_ptr<const Tables> cache[sizeof(REFERENCE_FUNCTIONS) / sizeof(REFERENCE_FUNCTIONS[0])];
+
+        std::lock_guard<std::mutex> lock(mutex);
+        std::shared_ptr<const Tables>& tables = cache[static_cast<int>(type)];
+        if (!tables)
+        {
+            const ReferenceFunction& function = referenceFunction(type);
+            const std::function<double(double)> voltage = [&function](double t) { return evaluateVoltage(function, t); };
+            const std::function<double(double)> slope = [&function](double t) { return evaluateSlope(function, t); };
+            const double e_min = voltage(function.t_min);
+            const double e_max = voltage(function.t_max);
+
+            auto built = std::make_shared<Tables>();
+            built->voltage.build(voltage, slope, function.t_min, function.t_max, THERMOCOUPLE_SEGMENTS);
+            built->temperature.build(
+                [&](double e) { return invert(voltage, slope, e, function.t_min, function.t_max); },
+                [&](double e) { return 1.0 / slope(invert(voltage, slope, e, function.t_min, function.t_max)); },
+                e_min, e_max, THERMOCOUPLE_SEGMENTS);
+            tables = built;
+        }
+        return tables;
+    }
+
+    ThermocoupleType ThermocoupleLinearizer::getType() const
+    {
+        return m_type;
+    }
+
+    double ThermocoupleLinearizer::getMinTemperature() const
+    {
+        return referenceFunction(m_type).t_min;
+    }
+
+    double ThermocoupleLinearizer::getMaxTemperature() const
+    {
+        return referenceFunction(m_type).t_max;
+    }
+
+    double ThermocoupleLinearizer::referenceVoltage(ThermocoupleType type, double celsius)
+    {
+        return evaluateVoltage(referenceFunction(type), celsius);
+    }
+
+    double ThermocoupleLinearizer::toVoltage(double celsius) const
+    {
+        return m_tables->voltage(celsius);
+    }
+
+    double ThermocoupleLinearizer::toTemperature(double mv) const
+    {
+        return m_tables->temperature(mv);
+    }
+
+    void ThermocoupleLinearizer::linearize(const float* mv, std::size_t count, double cjc, float* celsius) const
+    {
+        const PiecewiseCubic& temperature = m_tables->temperature;
+        const double cold = m_tables->voltage(cjc);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            celsius[i] = static_cast<float>(temperature(mv[i] + cold));
+        }
+    }
+
+    void ThermocoupleLinearizer::linearize(const float* mv, const float* cjc, std::size_t count, float* celsius) const
+    {
+        const PiecewiseCubic& voltage = m_tables->voltage;
+        const PiecewiseCubic& temperature = m_tables->temperature;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            celsius[i] = static_cast<float>(temperature(mv[i] + voltage(cjc[i])));
+        }
+    }
+
+
+    RtdLinearizer::RtdLinearizer(const RtdCoefficients& coefficients)
+        : m_coefficients(coefficients)
+    {
+        const double a = coefficients.a;
+        const double b = coefficients.b;
+        const double c = coefficients.c;
+        const std::function<double(double)> ratio = [=](double t)
+        {
+            return 1 + a * t + b * t * t + (t < 0 ? c * (t - 100) * t * t * t : 0.0);
+        };
+        const std::function<double(double)> slope = [=](double t)
+        {
+            return a + 2 * b * t + (t < 0 ? c * (4 * t - 300) * t * t : 0.0);
+        };
+
+        m_temperature.build(
+            [&](double r) { return invert(ratio, slope, r, RTD_MIN_TEMPERATURE, RTD_MAX_TEMPERATURE); },
+            [&](double r) { return 1.0 / slope(invert(ratio, slope, r, RTD_MIN_TEMPERATURE, RTD_MAX_TEMPERATURE)); },
+            ratio(RTD_MIN_TEMPERATURE), ratio(RTD_MAX_TEMPERATURE), RTD_SEGMENTS);
+    }
+
+    const RtdCoefficients& RtdLinearizer::getCoefficients() const
+    {
+        return m_coefficients;
+    }
+
+    double RtdLinearizer::toResistance(double celsius) const
+    {
+        const RtdCoefficients& k = m_coefficients;
+        const double t = celsius;
+        return k.r0 * (1 + k.a * t + k.b * t * t + (t < 0 ? k.c * (t - 100) * t * t * t : 0.0));
+    }
+
+    double RtdLinearizer::toTemperature(double ohm) const
+    {
+        return m_temperature(ohm / m_coefficients.r0);
+    }
+
+    void RtdLinearizer::linearize(const float* ohm, std::size_t count, float* celsius) const
+    {
+        const double factor = 1.0 / m_coefficients.r0;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            celsius[i] = static_cast<float>(m_temperature(ohm[i] * factor));
+        }
+    }
+
+} // trion
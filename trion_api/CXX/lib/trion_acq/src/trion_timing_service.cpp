@@ -0,0 +1,371 @@
+// Copyright (c) DEWETRON GmbH 2026
+
+#include "trion_timing_service.h"
+#include "dewepxi_apicore.h"
+#include <cmath>
+#include <cstdlib>
+
+namespace
+{
+    const int64_t NS_PER_SECOND = INT64_C(1000000000);
+    const int64_t SECONDS_PER_DAY = 86400;
+
+    /**
+     * A fitted rate further off than this is not a real oscillator drift
+     * but an artefact of too coarse anchors
+     */
+    const double MAX_DRIFT_PPM = 500.0;
+
+    const int DEFAULT_LEAP_SECONDS = 37;
+
+    /**
+     * Days from 1970-01-01 to January 1st of a year, proleptic Gregorian
+     */
+    int64_t daysFromEpoch(int year)
+    {
+        const int64_t y = static_cast<int64_t>(year) - 1;
+        const int64_t era = (y >= 0 ? y : y - 399) / 400;
+        const int64_t yoe = y - era * 400;
+        // day of the shifted (March based) year of January 1st
+        const int64_t doy = 306;
+        const int64_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+        return era * 146097 + doe - 719468;
+    }
+
+} // namespace
+
+
+namespace trion
+{
+    TimingService::TimingService(int board_no, double sample_rate, TimingListener& listener)
+        : m_listener(listener)
+        , m_nominal_ns_per_sample(sample_rate > 0 ? 1e9 / sample_rate : 0)
+        , m_leap_seconds(DEFAULT_LEAP_SECONDS)
+        , m_target("BoardID" + std::to_string(board_no) + "/AcqProp/Timing/SystemTime")
+        , m_status()
+        , m_was_locked(false)
+        , m_anchors()
+        , m_anchor_count(0)
+        , m_anchor_next(0)
+        , m_bin_count(0)
+        , m_bin_first()
+        , m_bin_sample_sum(0)
+        , m_bin_ns_sum(0)
+        , m_poll_valid(false)
+        , m_poll_sample(0)
+        , m_poll_second_ns(0)
+        , m_base_sample(0)
+        , m_base_ns(0)
+    {
+        m_status.board_no = board_no;
+        m_status.ns_per_sample = m_nominal_ns_per_sample;
+    }
+
+    void TimingService::setLeapSeconds(int tai_minus_utc)
+    {
+        m_leap_seconds = tai_minus_utc;
+    }
+
+    int TimingService::getLeapSeconds() const
+    {
+        return m_leap_seconds;
+    }
+
+    void TimingService::reset()
+    {
+        m_anchor_count = 0;
+        m_anchor_next = 0;
+        m_bin_count = 0;
+        m_poll_valid = false;
+        m_status.valid = false;
+        m_status.anchors = 0;
+        m_status.ns_per_sample = m_nominal_ns_per_sample;
+        m_status.drift_ppm = 0;
+        m_status.residual_ns = 0;
+    }
+
+    int TimingService::poll()
+    {
+        sint32 state = 0;
+        int err = DeWeGetParam_i32(m_status.board_no, CMD_TIMING_STATE, &state);
+        if (err > 0)
+        {
+            return err;
+        }
+
+        if (state != m_status.state)
+        {
+            const sint32 previous = m_status.state;
+            m_status.state = state;
+            m_listener.onTimingStateChanged(m_status, previous, state);
+        }
+
+        const bool locked = state == TIMINGSTATE_LOCKED;
+        if (locked && !m_was_locked && m_anchor_count > 0)
+        {
+            reset();
+            ++m_status.relocks;
+            m_listener.onRelock(m_status);
+        }
+        m_was_locked = locked;
+        if (!locked)
+        {
+            m_poll_valid = false;
+            return ERR_NONE;
+        }
+
+        TimeAnchor anchor;
+        bool taken = false;
+        err = readAnchor(anchor, taken);
+        if (err > 0)
+        {
+            return err;
+        }
+        if (taken)
+        {
+            addAnchor(anchor.sample, anchor.utc_ns);
+        }
+        return ERR_NONE;
+    }
+
+    int TimingService::readAnchor(TimeAnchor& anchor, bool& taken)
+    {
+        taken = false;
+
+        // the latch does not return the count, bracket it with two reads
+        sint32 before = 0;
+        sint32 after = 0;
+        sint32 dummy = 0;
+        int err = DeWeGetParam_i32(m_status.board_no, CMD_BOARD_ACT_SAMPLE_COUNT, &before);
+        if (err > 0
+            || (err = DeWeGetParam_i32(m_status.board_no, CMD_TIMING_TIME, &dummy)) > 0
+            || (err = DeWeGetParam_i32(m_status.board_no, CMD_BOARD_ACT_SAMPLE_COUNT, &after)) > 0)
+        {
+            return err;
+        }
+        const uint32_t count = static_cast<uint32_t>(before)
+            + (static_cast<uint32_t>(after) - static_cast<uint32_t>(before)) / 2;
+
+        double year = 0;
+        double day = 0;
+        double sec = 0;
+        if ((err = readTimeElement("Year", year)) > 0
+            || (err = readTimeElement("Day", day)) > 0
+            || (err = readTimeElement("Sec", sec)) > 0)
+        {
+            return err;
+        }
+
+        // the latched count is 32 bit, extend it with the previous reading
+        uint64_t sample = count;
+        if (m_poll_valid)
+        {
+            sample |= m_poll_sample & ~UINT64_C(0xFFFFFFFF);
+            if (sample < m_poll_sample)
+            {
+                sample += UINT64_C(0x100000000);
+            }
+        }
+        const int64_t second_ns = toUtcNanoseconds(static_cast<int>(year), static_cast<int>(day), std::floor(sec));
+
+        if (m_poll_valid && second_ns > m_poll_second_ns)
+        {
+            // the second started after the previous reading and at most one second before this one
+            uint64_t first = m_poll_sample;
+            if (m_nominal_ns_per_sample > 0)
+            {
+                const uint64_t samples_per_second = static_cast<uint64_t>(NS_PER_SECOND / m_nominal_ns_per_sample);
+                if (sample - first > samples_per_second)
+                {
+                    first = sample - samples_per_second;
+                }
+            }
+            anchor.sample = first + (sample - first) / 2;
+            anchor.utc_ns = second_ns;
+            taken = true;
+        }
+
+        m_poll_valid = true;
+        m_poll_sample = sample;
+        m_poll_second_ns = second_ns;
+        return ERR_NONE;
+    }
+
+    int TimingService::readTimeElement(const char* item, double& value)
+    {
+        char buffer[64];
+        int err = DeWeGetParamStruct_str(m_target.c_str(), item, buffer, sizeof(buffer));
+        if (err == ERR_NONE)
+        {
+            buffer[sizeof(buffer) - 1] = 0;
+            value = std::strtod(buffer, nullptr);
+        }
+        return err;
+    }
+
+    void TimingService::addAnchor(uint64_t sample, int64_t utc_ns)
+    {
+        if (m_anchor_count == 0)
+        {
+            storeAnchor(sample, utc_ns);
+            return;
+        }
+
+        const TimeAnchor& last = m_anchors[(m_anchor_next + MAX_ANCHORS - 1) % MAX_ANCHORS];
+        if (sample < last.sample)
+        {
+            reset();
+            storeAnchor(sample, utc_ns);
+            return;
+        }
+        if (sample == last.sample)
+        {
+            return;
+        }
+
+        // average the anchors of one spacing interval, the errors of single
+        // anchors are too large for a short baseline
+        if (m_bin_count == 0)
+        {
+            m_bin_first = TimeAnchor{ sample, utc_ns };
+            m_bin_sample_sum = 0;
+            m_bin_ns_sum = 0;
+        }
+        m_bin_sample_sum += static_cast<int64_t>(sample - m_bin_first.sample);
+        m_bin_ns_sum += utc_ns - m_bin_first.utc_ns;
+        ++m_bin_count;
+
+        if (utc_ns - last.utc_ns >= ANCHOR_SPACING_S * NS_PER_SECOND)
+        {
+            const int64_t count = static_cast<int64_t>(m_bin_count);
+            m_bin_count = 0;
+            storeAnchor(m_bin_first.sample + m_bin_sample_sum / count, m_bin_first.utc_ns + m_bin_ns_sum / count);
+        }
+    }
+
+    void TimingService::storeAnchor(uint64_t sample, int64_t utc_ns)
+    {
+        m_anchors[m_anchor_next] = TimeAnchor{ sample, utc_ns };
+        m_anchor_next = (m_anchor_next + 1) % MAX_ANCHORS;
+        if (m_anchor_count < MAX_ANCHORS)
+        {
+            ++m_anchor_count;
+        }
+        fit();
+    }
+
+    void TimingService::fit()
+    {
+        // relative to the newest anchor, keeps the sums small
+        const TimeAnchor& ref = m_anchors[(m_anchor_next + MAX_ANCHORS - 1) % MAX_ANCHORS];
+        const double n = static_cast<double>(m_anchor_count);
+
+        double sum_x = 0;
+        double sum_y = 0;
+        for (std::size_t i = 0; i < m_anchor_count; ++i)
+        {
+            sum_x -= static_cast<double>(ref.sample - m_anchors[i].sample);
+            sum_y += static_cast<double>(m_anchors[i].utc_ns - ref.utc_ns);
+        }
+        const double mean_x = sum_x / n;
+        const double mean_y = sum_y / n;
+
+        double sxx = 0;
+        double sxy = 0;
+        for (std::size_t i = 0; i < m_anchor_count; ++i)
+        {
+            const double dx = -static_cast<double>(ref.sample - m_anchors[i].sample) - mean_x;
+            const double dy = static_cast<double>(m_anchors[i].utc_ns - ref.utc_ns) - mean_y;
+            sxx += dx * dx;
+            sxy += dx * dy;
+        }
+
+        double slope = m_nominal_ns_per_sample;
+        if (sxx > 0 && m_nominal_ns_per_sample > 0 && m_anchor_count >= MAX_ANCHORS / 2)
+        {
+            const double fitted = sxy / sxx;
+            if (std::fabs(fitted / m_nominal_ns_per_sample - 1.0) * 1e6 <= MAX_DRIFT_PPM)
+            {
+                slope = fitted;
+            }
+        }
+        const double intercept = mean_y - slope * mean_x;
+
+        double sum_sq = 0;
+        for (std::size_t i = 0; i < m_anchor_count; ++i)
+        {
+            const double x = -static_cast<double>(ref.sample - m_anchors[i].sample);
+            const double y = static_cast<double>(m_anchors[i].utc_ns - ref.utc_ns);
+            const double r = y - (intercept + slope * x);
+            sum_sq += r * r;
+        }
+
+        m_base_sample = ref.sample;
+        m_base_ns = ref.utc_ns + std::llround(intercept);
+
+        m_status.valid = true;
+        m_status.anchors = m_anchor_count;
+        m_status.ns_per_sample = slope;
+        m_status.drift_ppm = m_nominal_ns_per_sample > 0 ? (slope / m_nominal_ns_per_sample - 1.0) * 1e6 : 0;
+        m_status.residual_ns = std::sqrt(sum_sq / n);
+    }
+
+    bool TimingService::isValid() const
+    {
+        return m_status.valid;
+    }
+
+    const TimingStatus& TimingService::getStatus() const
+    {
+        return m_status;
+    }
+
+    int64_t TimingService::scaleOffset(TimeScale scale) const
+    {
+        return scale == TimeScale::TAI ? m_leap_seconds * NS_PER_SECOND : 0;
+    }
+
+    int64_t TimingService::toTime(uint64_t sample, TimeScale scale) const
+    {
+        const double offset = static_cast<double>(static_cast<int64_t>(sample - m_base_sample));
+        return m_base_ns + scaleOffset(scale) + std::llround(offset * m_status.ns_per_sample);
+    }
+
+    void TimingService::toTime(uint64_t first_sample, std::size_t count, int64_t* ns, TimeScale scale) const
+    {
+        const int64_t base = toTime(first_sample, scale);
+        const double step = m_status.ns_per_sample;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            ns[i] = base + static_cast<int64_t>(static_cast<double>(i) * step + 0.5);
+        }
+    }
+
+    void TimingService::toTime(const uint64_t* samples, std::size_t count, int64_t* ns, TimeScale scale) const
+    {
+        const int64_t base = m_base_ns + scaleOffset(scale);
+        const double step = m_status.ns_per_sample;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const double offset = static_cast<double>(static_cast<int64_t>(samples[i] - m_base_sample));
+            ns[i] = base + std::llround(offset * step);
+        }
+    }
+
+    int64_t TimingService::toSample(int64_t ns, TimeScale scale) const
+    {
+        if (m_status.ns_per_sample <= 0)
+        {
+            return 0;
+        }
+        const double offset = static_cast<double>(ns - scaleOffset(scale) - m_base_ns);
+        return static_cast<int64_t>(m_base_sample) + std::llround(offset / m_status.ns_per_sample);
+    }
+
+    int64_t TimingService::toUtcNanoseconds(int year, int day_of_year, double second_of_day)
+    {
+        const int64_t days = daysFromEpoch(year) + day_of_year - 1;
+        return days * SECONDS_PER_DAY * NS_PER_SECOND + std::llround(second_of_day * 1e9);
+    }
+
+} // trion
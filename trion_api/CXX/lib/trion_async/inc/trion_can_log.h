@@ -0,0 +1,206 @@
+// Copyright (c) DEWETRON GmbH 2026
+#pragma once
+
+#include "dewepxi_types.h"
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace trion
+{
+    /**
+     * Compact CAN frame log.
+     *
+     * Frames are stored in chunks. Every chunk has its own message id
+     * dictionary and stores per frame:
+     * - zigzag varint timestamp delta in ns to the previous frame
+     * - varint dictionary index of the message id
+     * - CanNo, StandardExtended and FrameType packed in two bytes
+     * - varint DataLength and, if changed, varint ErrorCounter
+     * - DataLength payload bytes, not the full 64 byte CanData
+     *
+     * A classic 8 byte CAN frame needs about 14 bytes instead of the
+     * 104 bytes of BOARD_CAN_FD_FRAME_NG.
+     *
+     * An index of all chunks (time range, id range, id hash mask) is
+     * written at the end of the file and allows seeking by time or id.
+     * A file without a valid index, eg after a crash of the writer, is
+     * recovered by scanning the chunks up to the first incomplete one.
+     * All values are little endian.
+     */
+
+    /**
+     * Number of payload bytes of a frame.
+     * DataLength of the TRION frames is a byte count, as in the SDK
+     * examples, not a DLC code: 12 means 12 bytes. Counts above 64 are
+     * clamped to the size of CanData.
+     */
+    uint32_t canPayloadLength(uint32_t data_length);
+
+    /**
+     * Index entry of one chunk
+     */
+    struct CanLogChunkInfo
+    {
+        uint64_t file_offset;
+        uint64_t first_time_ns;     //!< TimeStampSeconds * 1e9 + TimeStampNanoSeconds
+        uint64_t last_time_ns;
+        uint32_t min_id;
+        uint32_t max_id;
+        uint64_t id_mask;           //!< bit canLogIdHash(id) is set for every id in the chunk
+        uint32_t frame_count;
+    };
+
+    /**
+     * Hash of a message id to a bit number of CanLogChunkInfo::id_mask.
+     */
+    unsigned canLogIdHash(uint32_t id);
+
+    class CanLogWriter
+    {
+    public:
+        enum { DEFAULT_CHUNK_FRAMES = 4096 };
+
+        /**
+         * Create a new log file.
+         * Throws std::runtime_error if the file cannot be created.
+         */
+        explicit CanLogWriter(const std::string& file_name, std::size_t chunk_frames = DEFAULT_CHUNK_FRAMES);
+
+        /**
+         * Finishes the file if close() was not called.
+         */
+        ~CanLogWriter();
+
+        void write(const BOARD_CAN_FD_FRAME_NG* frames, std::size_t count);
+
+        /**
+         * Write frames whose timestamps were converted separately,
+         * eg with CanTimestampConverter::toNanoseconds.
+         */
+        void write(const BOARD_CAN_FD_FRAME* frames, const int64_t* time_ns, std::size_t count);
+
+        /**
+         * Write the pending chunk and the index, then close the file.
+         */
+        void close();
+
+        uint64_t getFrameCount() const;
+        uint64_t getBytesWritten() const;
+
+    private:
+        void append(uint64_t time_ns, uint8_t can_no, uint32_t id, uint32_t dlc,
+            uint32_t std_ext, uint32_t frame_type, uint32_t error_counter, const uint8_t* data);
+        void flushChunk();
+
+    private:
+        std::ofstream m_out;
+        std::size_t m_chunk_frames;
+
+        // current chunk
+        std::vector<uint8_t> m_records;
+        std::vector<uint32_t> m_dict;
+        std::unordered_map<uint32_t, uint32_t> m_dict_index;
+        CanLogChunkInfo m_chunk;
+        uint64_t m_chunk_base_ns;
+        uint64_t m_prev_time_ns;
+        uint32_t m_prev_error_counter;
+
+        std::vector<CanLogChunkInfo> m_index;
+        std::vector<uint8_t> m_scratch;
+        uint64_t m_frame_count;
+        uint64_t m_offset;
+    };
+
+    /**
+     * View of one decoded record. data points into the chunk buffer
+     * of the reader and stays valid until the next chunk is loaded.
+     */
+    struct CanLogRecord
+    {
+        uint64_t time_ns;
+        uint32_t message_id;
+        uint32_t data_length;       //!< DataLength as logged
+        uint32_t payload_size;      //!< number of bytes at data
+        uint32_t standard_extended;
+        uint32_t frame_type;
+        uint32_t error_counter;
+        uint8_t can_no;
+        const uint8_t* data;
+
+        /**
+         * Expand to BOARD_CAN_FD_FRAME_NG, only payload_size bytes of CanData are written.
+         */
+        void toFrame(BOARD_CAN_FD_FRAME_NG& frame) const;
+    };
+
+    class CanLogReader
+    {
+    public:
+        /**
+         * Open a log file and load its index, or rebuild it from the chunks
+         * if the file was not closed.
+         * Throws std::runtime_error for missing or malformed files.
+         */
+        explicit CanLogReader(const std::string& file_name);
+
+        /**
+         * True if the index was rebuilt by scanning the chunks.
+         */
+        bool isRecovered() const;
+
+        std::size_t getChunkCount() const;
+        const CanLogChunkInfo& getChunkInfo(std::size_t chunk) const;
+
+        /**
+         * Index of the first chunk that may contain frames at or after time_ns.
+         * @return getChunkCount() if there is none
+         */
+        std::size_t findChunk(uint64_t time_ns) const;
+
+        /**
+         * Check the chunk index whether a chunk may contain an id.
+         */
+        bool mayContainId(std::size_t chunk, uint32_t id) const;
+
+        /**
+         * Load a chunk into the internal buffer.
+         * The records are then iterated with nextRecord().
+         */
+        void loadChunk(std::size_t chunk);
+
+        /**
+         * Decode the next record of the loaded chunk.
+         * @return false at the end of the chunk
+         */
+        bool nextRecord(CanLogRecord& record);
+
+        /**
+         * Decode a complete chunk.
+         * @param id_filter only frames with this id are returned, unless it is -1
+         */
+        void readChunk(std::size_t chunk, std::vector<BOARD_CAN_FD_FRAME_NG>& frames, int64_t id_filter = -1);
+
+    private:
+        bool readIndex(uint64_t file_size);
+        void recoverIndex(uint64_t file_size);
+
+    private:
+        std::ifstream m_in;
+        std::vector<CanLogChunkInfo> m_index;
+        bool m_recovered;
+
+        // loaded chunk
+        std::vector<uint8_t> m_buffer;
+        std::vector<uint32_t> m_dict;
+        const uint8_t* m_pos;
+        const uint8_t* m_end;
+        uint32_t m_remaining;
+        uint64_t m_time_ns;
+        uint32_t m_error_counter;
+    };
+
+} // trion
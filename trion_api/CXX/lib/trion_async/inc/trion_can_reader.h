@@ -0,0 +1,186 @@
+// Copyright (c) DEWETRON GmbH 2026
+#pragma once
+
+#include "dewepxi_types.h"
+#include "trion_spsc_queue.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace trion
+{
+    /**
+     * Selects the frames delivered to a CanSubscription.
+     */
+    struct CanFilter
+    {
+        int board_no;
+        int port;           //!< CanNo, -1 for all ports of the board
+        uint32_t id_min;    //!< inclusive
+        uint32_t id_max;    //!< inclusive
+
+        bool matches(const BOARD_CAN_FD_FRAME& frame) const
+        {
+            return (port < 0 || frame.CanNo == port)
+                && frame.MessageId >= id_min
+                && frame.MessageId <= id_max;
+        }
+    };
+
+    /**
+     * Consumer side of a subscription.
+     * Each subscription owns one SPSC queue, filled by the reader
+     * thread of its board. pop() must only be called from one thread.
+     */
+    class CanSubscription
+    {
+    public:
+        CanSubscription(const CanFilter& filter, std::size_t capacity);
+
+        const CanFilter& getFilter() const;
+
+        /**
+         * Fetch up to max_count frames.
+         * @return the number of frames copied to frames
+         */
+        std::size_t pop(BOARD_CAN_FD_FRAME* frames, std::size_t max_count);
+
+        std::size_t available() const;
+
+        /**
+         * Number of frames dropped because the queue was full.
+         */
+        uint64_t getDropped() const;
+
+    private:
+        friend class CanReaderService;
+
+        CanFilter m_filter;
+        SpscQueue<BOARD_CAN_FD_FRAME> m_queue;
+        std::atomic<uint64_t> m_dropped;
+    };
+
+    typedef std::shared_ptr<CanSubscription> CanSubscriptionPtr;
+
+    /**
+     * CAN ingestion service with one reader thread per board.
+     *
+     * Each reader thread polls DeWeReadCANEx, optionally pinned to a CPU
+     * core, and pushes the frames into the queues of all matching
+     * subscriptions. The reader never blocks on a slow consumer: frames
+     * are dropped and counted per subscription instead.
+     *
+     * Subscriptions have to be created before start().
+     *
+     * With auto-tune enabled, the reader threads measure the frame rate and
+     * recommend a CMD_ASYNC_POLLING_TIME so that each driver poll carries
+     * about TARGET_FRAMES_PER_POLL frames. The boards are never reprogrammed
+     * while CAN is running: the recommendation is written by the next
+     * configure(), ie on the next restart of the acquisition.
+     */
+    class CanReaderService
+    {
+    public:
+        enum
+        {
+            MIN_POLLING_TIME_MS = 5,
+            MAX_POLLING_TIME_MS = 100,
+            TARGET_FRAMES_PER_POLL = 256,
+            READ_BATCH = 2048,              //!< frames fetched per DeWeReadCANEx call
+        };
+
+        struct BoardConfig
+        {
+            int board_no;
+            int cpu_core;           //!< -1 for no pinning
+            int polling_time_ms;    //!< initial CMD_ASYNC_POLLING_TIME
+            int frame_size;         //!< CMD_ASYNC_FRAME_SIZE
+
+            explicit BoardConfig(int board = 0)
+                : board_no(board)
+                , cpu_core(-1)
+                , polling_time_ms(33)
+                , frame_size(8)
+            {
+            }
+        };
+
+        struct BoardStatistics
+        {
+            uint64_t frames;
+            uint64_t polls;
+            uint64_t errors;
+            int last_error;
+            double frame_rate;      //!< frames per second, last measurement window
+            int polling_time_ms;
+            int recommended_polling_time_ms;    //!< applied by the next configure() with auto-tune
+        };
+
+        CanReaderService();
+        ~CanReaderService();
+
+        CanReaderService(const CanReaderService&) = delete;
+        CanReaderService& operator=(const CanReaderService&) = delete;
+
+        void addBoard(const BoardConfig& config);
+
+        /**
+         * Subscribe to all frames of one port (port -1 for all ports).
+         */
+        CanSubscriptionPtr subscribe(int board_no, int port, std::size_t capacity = 4096);
+
+        /**
+         * Subscribe to an inclusive message id range.
+         */
+        CanSubscriptionPtr subscribe(int board_no, int port, uint32_t id_min, uint32_t id_max, std::size_t capacity = 4096);
+
+        void setAutoTune(bool enable);
+        bool getAutoTune() const;
+
+        /**
+         * Write CMD_ASYNC_POLLING_TIME and CMD_ASYNC_FRAME_SIZE to all boards.
+         * Has to be called before CMD_UPDATE_PARAM_ALL, with CAN stopped.
+         * With auto-tune, the polling time is the recommendation of the
+         * previous run.
+         * @return the first API error or ERR_NONE
+         */
+        int configure();
+
+        /**
+         * Start the reader threads.
+         * CAN has to be started (DeWeStartCAN) by the caller.
+         */
+        void start();
+
+        /**
+         * Stop and join the reader threads.
+         */
+        void stop();
+
+        bool isRunning() const;
+
+        BoardStatistics getStatistics(int board_no) const;
+
+        /**
+         * Polling time that yields about TARGET_FRAMES_PER_POLL frames per poll,
+         * clamped to [MIN_POLLING_TIME_MS, MAX_POLLING_TIME_MS].
+         */
+        static int recommendPollingTime(double frame_rate);
+
+    private:
+        struct Board;
+
+        void readerLoop(Board& board);
+        void autoTune(Board& board, double frame_rate);
+        Board* findBoard(int board_no) const;
+
+    private:
+        std::vector<std::unique_ptr<Board>> m_boards;
+        std::atomic<bool> m_running;
+        std::atomic<bool> m_auto_tune;
+    };
+
+} // trion
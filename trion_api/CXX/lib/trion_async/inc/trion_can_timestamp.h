@@ -0,0 +1,151 @@
+// Copyright (c) DEWETRON GmbH 2026
+#pragma once
+
+#include "dewepxi_types.h"
+#include "trion_counter_extender.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace trion
+{
+    /**
+     * Unit of the CAN SyncCounter as configured with the
+     * CAN channel property "SyncCounter".
+     */
+    enum class CanSyncCounterMode
+    {
+        SampleCount,    //!< "SampleCount": counts AI samples of the board
+        Count10MHz,     //!< "10 MHzCount": counts 100ns ticks
+    };
+
+    /**
+     * Maps CAN frame timestamps onto the AI sample timeline of the same board.
+     *
+     * The common timeline is nanoseconds since acquisition start, which is
+     * the time of AI sample 0. Fractional AI sample indices are derived from
+     * this timeline using the board sample rate.
+     *
+     * Supported timestamp sources:
+     * - SyncCounterEx of BOARD_CAN_FRAME and BOARD_CAN_FD_FRAME (default)
+     * - SyncCounter of BOARD_CAN_FRAME and BOARD_CAN_FD_FRAME, 32 bit values
+     *   are extended to 64 bit by tracking roll-overs across calls
+     * - TimeStampSeconds/TimeStampNanoSeconds of BOARD_CAN_FD_FRAME_NG,
+     *   relative to the origin set with setNgTimeOrigin()
+     *
+     * All batch functions process a complete frame array in one tight loop
+     * and write to caller provided output arrays.
+     */
+    class CanTimestampConverter
+    {
+    public:
+        /**
+         * @param sample_rate is the AI sample rate of the board in Hz
+         * @param mode is the configured unit of the CAN SyncCounter
+         */
+        CanTimestampConverter(double sample_rate, CanSyncCounterMode mode);
+
+        void setSampleRate(double sample_rate);
+        double getSampleRate() const;
+
+        void setSyncCounterMode(CanSyncCounterMode mode);
+        CanSyncCounterMode getSyncCounterMode() const;
+
+        /**
+         * Select SyncCounterEx (default) or the 32 bit SyncCounter
+         * as timestamp source for BOARD_CAN_FRAME and BOARD_CAN_FD_FRAME.
+         */
+        void setUseSyncCounterEx(bool use_ex);
+        bool getUseSyncCounterEx() const;
+
+        /**
+         * Set the BOARD_CAN_FD_FRAME_NG timestamp that corresponds
+         * to AI sample 0. Defaults to 0s, 0ns.
+         */
+        void setNgTimeOrigin(uint64_t seconds, uint32_t nanoseconds);
+
+        /**
+         * Forget the roll-over state of the 32 bit SyncCounter.
+         * Has to be called when a new acquisition is started.
+         */
+        void resetSyncCounterExtension();
+
+        /**
+         * Extend a 32 bit SyncCounter to 64 bit.
+         * Values have to be passed in acquisition order.
+         */
+        uint64_t extendSyncCounter(uint32_t sync_counter);
+
+        /**
+         * Convert a 64 bit SyncCounter value to nanoseconds since acquisition start.
+         */
+        int64_t counterToNanoseconds(uint64_t counter) const;
+
+        /**
+         * Convert a 64 bit SyncCounter value to a fractional AI sample index.
+         */
+        double counterToSampleIndex(uint64_t counter) const;
+
+        /**
+         * Convert a NG frame timestamp to nanoseconds since acquisition start.
+         */
+        int64_t ngTimeToNanoseconds(uint64_t seconds, uint32_t nanoseconds) const;
+
+        /**
+         * Convert nanoseconds since acquisition start to a fractional AI sample index.
+         */
+        double nanosecondsToSampleIndex(int64_t ns) const;
+
+        /**
+         * Batch conversion of 64 bit SyncCounter values.
+         */
+        void countersToNanoseconds(const uint64_t* counters, std::size_t count, int64_t* ns) const;
+        void countersToSampleIndex(const uint64_t* counters, std::size_t count, double* index) const;
+
+        /**
+         * Batch conversion of nanoseconds to fractional AI sample indices.
+         */
+        void nanosecondsToSampleIndex(const int64_t* ns, std::size_t count, double* index) const;
+
+        /**
+         * Batch conversion of frame timestamps to nanoseconds since acquisition start.
+         * @param frames points to the first frame
+         * @param count is the number of frames
+         * @param ns receives count timestamps
+         */
+        void toNanoseconds(const BOARD_CAN_FRAME* frames, std::size_t count, int64_t* ns);
+        void toNanoseconds(const BOARD_CAN_FD_FRAME* frames, std::size_t count, int64_t* ns);
+        void toNanoseconds(const BOARD_CAN_FD_FRAME_NG* frames, std::size_t count, int64_t* ns) const;
+
+        /**
+         * Batch conversion of frame timestamps to fractional AI sample indices.
+         * @param frames points to the first frame
+         * @param count is the number of frames
+         * @param index receives count sample indices
+         */
+        void toSampleIndex(const BOARD_CAN_FRAME* frames, std::size_t count, double* index);
+        void toSampleIndex(const BOARD_CAN_FD_FRAME* frames, std::size_t count, double* index);
+        void toSampleIndex(const BOARD_CAN_FD_FRAME_NG* frames, std::size_t count, double* index) const;
+
+    private:
+        template <typename FRAME>
+        void loadCounters(const FRAME* frames, std::size_t count, uint64_t* counters);
+
+        void updateFactors();
+
+    private:
+        double m_sample_rate;
+        CanSyncCounterMode m_mode;
+        bool m_use_sync_counter_ex;
+
+        // derived conversion factors
+        double m_ns_per_count;
+        double m_samples_per_count;
+        double m_samples_per_ns;
+
+        uint64_t m_ng_origin_sec;
+        uint32_t m_ng_origin_nsec;
+
+        CounterExtender m_sync_counter;
+    };
+
+} // trion
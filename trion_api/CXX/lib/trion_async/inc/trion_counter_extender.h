@@ -0,0 +1,51 @@
+// Copyright (c) DEWETRON GmbH 2026
+#pragma once
+
+#include <cstdint>
+
+namespace trion
+{
+    /**
+     * Extends a free running counter of mask width to 64 bit.
+     *
+     * A value smaller than the previous one counts as one roll-over, so
+     * values have to be passed in acquisition order and at least once per
+     * counter period.
+     */
+    class CounterExtender
+    {
+    public:
+        explicit CounterExtender(uint32_t mask = 0xFFFFFFFF)
+            : m_mask(mask)
+            , m_last(0)
+            , m_high(0)
+        {
+        }
+
+        /**
+         * Forget the roll-over state, eg on a new acquisition.
+         */
+        void reset()
+        {
+            m_last = 0;
+            m_high = 0;
+        }
+
+        uint64_t extend(uint32_t value)
+        {
+            value &= m_mask;
+            if (value < m_last)
+            {
+                m_high += static_cast<uint64_t>(m_mask) + 1;
+            }
+            m_last = value;
+            return m_high | value;
+        }
+
+    private:
+        uint32_t m_mask;
+        uint32_t m_last;
+        uint64_t m_high;
+    };
+
+} // trion
@@ -0,0 +1,262 @@
+// Copyright (c) DEWETRON GmbH 2026
+#pragma once
+
+#include "dewepxi_types.h"
+#include "trion_counter_extender.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace trion
+{
+    /**
+     * Timestamp of a GPS message: the SyncCounter and LastPPS
+     * values of the first byte of the message.
+     */
+    struct GpsStamp
+    {
+        uint64_t sync_counter;
+        uint64_t last_pps;
+    };
+
+    /**
+     * UTC time of day as sent by NMEA sentences (hhmmss.sss)
+     */
+    struct NmeaUtcTime
+    {
+        bool valid;
+        uint8_t hour;
+        uint8_t minute;
+        uint8_t second;
+        uint16_t millisecond;
+    };
+
+    /**
+     * GGA: Global positioning system fix data
+     * Numeric fields not sent by the receiver are NaN.
+     */
+    struct NmeaGga
+    {
+        GpsStamp stamp;
+        char talker[3];             //!< eg "GP", "GN"
+        NmeaUtcTime time;
+        double latitude;            //!< degrees, south is negative
+        double longitude;           //!< degrees, west is negative
+        uint8_t quality;            //!< 0 = invalid, 1 = GPS fix, 2 = DGPS fix, ...
+        uint8_t satellites;         //!< number of satellites in use
+        double hdop;
+        double altitude;            //!< meters above mean sea level
+        double geoid_separation;    //!< meters
+    };
+
+    /**
+     * RMC: Recommended minimum specific GNSS data
+     */
+    struct NmeaRmc
+    {
+        GpsStamp stamp;
+        char talker[3];
+        NmeaUtcTime time;
+        bool active;                //!< status 'A'
+        double latitude;
+        double longitude;
+        double speed_knots;
+        double course;              //!< degrees true
+        uint8_t day;
+        uint8_t month;
+        uint16_t year;              //!< 4 digits, 0 if no date was sent
+        double magnetic_variation;  //!< degrees, west is negative
+        char mode;                  //!< NMEA 2.3 mode indicator or 0
+    };
+
+    /**
+     * GSA: GNSS DOP and active satellites
+     */
+    struct NmeaGsa
+    {
+        enum { MAX_PRN = 12 };
+
+        GpsStamp stamp;
+        char talker[3];
+        char selection_mode;        //!< 'M' manual, 'A' automatic
+        uint8_t fix_type;           //!< 1 = no fix, 2 = 2D, 3 = 3D
+        uint8_t prn_count;
+        uint16_t prn[MAX_PRN];
+        double pdop;
+        double hdop;
+        double vdop;
+    };
+
+    /**
+     * GSV: GNSS satellites in view (up to four satellites per sentence)
+     */
+    struct NmeaGsv
+    {
+        enum { MAX_SATELLITES = 4 };
+
+        struct Satellite
+        {
+            uint16_t prn;
+            int16_t elevation;      //!< degrees, -1 if not sent
+            int16_t azimuth;        //!< degrees, -1 if not sent
+            int16_t snr;            //!< dBHz, -1 if not tracked
+        };
+
+        GpsStamp stamp;
+        char talker[3];
+        uint8_t total_messages;
+        uint8_t message_number;
+        uint8_t satellites_in_view;
+        uint8_t satellite_count;
+        Satellite satellites[MAX_SATELLITES];
+    };
+
+    /**
+     * UBX binary message.
+     * The payload points into the parser buffer and is only valid
+     * during the listener callback.
+     */
+    struct UbxMessage
+    {
+        GpsStamp stamp;
+        uint8_t msg_class;
+        uint8_t msg_id;
+        uint16_t length;
+        const uint8_t* payload;
+    };
+
+    enum class GpsParseError
+    {
+        NmeaChecksum,       //!< NMEA checksum mismatch
+        NmeaOverflow,       //!< NMEA sentence exceeds the assembly buffer
+        NmeaFormat,         //!< known sentence type with malformed fields
+        UbxChecksum,        //!< UBX Fletcher checksum mismatch
+        UbxOverflow,        //!< UBX payload exceeds the assembly buffer
+    };
+
+    /**
+     * Receives the parsed GPS messages.
+     * All callbacks are invoked synchronously from NmeaStreamParser::process.
+     */
+    class NmeaListener
+    {
+    public:
+        virtual ~NmeaListener() {}
+
+        virtual void onGga(const NmeaGga& /*gga*/) {}
+        virtual void onRmc(const NmeaRmc& /*rmc*/) {}
+        virtual void onGsa(const NmeaGsa& /*gsa*/) {}
+        virtual void onGsv(const NmeaGsv& /*gsv*/) {}
+
+        /**
+         * Called for every NMEA sentence with a valid checksum,
+         * including the types parsed above.
+         * @param sentence starts with '$' and excludes the checksum and line end
+         */
+        virtual void onSentence(const GpsStamp& /*stamp*/, const char* /*sentence*/, std::size_t /*length*/) {}
+
+        virtual void onUbx(const UbxMessage& /*msg*/) {}
+
+        virtual void onError(GpsParseError /*error*/, const GpsStamp& /*stamp*/) {}
+    };
+
+    /**
+     * Streaming NMEA 0183 and UBX parser for the GPS UART path.
+     *
+     * Bytes are assembled in a fixed buffer, no heap allocation happens
+     * after construction. Messages may span any number of process() calls.
+     * Every message is stamped with the SyncCounter of its first byte.
+     */
+    class NmeaStreamParser
+    {
+    public:
+        enum
+        {
+            MAX_NMEA_LENGTH = 128,      //!< NMEA allows 82 characters, some receivers send more
+            MAX_UBX_PAYLOAD = 1024,
+        };
+
+        struct Statistics
+        {
+            uint64_t bytes;
+            uint64_t nmea_sentences;
+            uint64_t ubx_messages;
+            uint64_t errors;
+        };
+
+        explicit NmeaStreamParser(NmeaListener& listener);
+
+        /**
+         * Drop any partially assembled message and reset the statistics.
+         */
+        void reset();
+
+        /**
+         * Consume frames read with DeWeReadDmaUart.
+         */
+        void process(const BOARD_UART_FRAME* frames, std::size_t count);
+
+        /**
+         * Consume frames obtained with DeWeReadDmaUartRawFrame, in place.
+         * The 32 bit SyncCounter and 24 bit LastPPS are extended to 64 bit.
+         */
+        void process(const BOARD_UART_RAW_FRAME* frames, std::size_t count);
+
+        /**
+         * Consume a contiguous run of bytes.
+         * @param data points to the first byte
+         * @param count is the number of bytes
+         * @param stamp is the timestamp of the first byte
+         * @param counter_per_byte is the SyncCounter increment per byte,
+         *        used to stamp messages starting within the run (0 = use stamp)
+         */
+        void process(const uint8_t* data, std::size_t count, const GpsStamp& stamp, double counter_per_byte = 0);
+
+        const Statistics& getStatistics() const;
+
+    private:
+        void consume(uint8_t byte, const GpsStamp& stamp);
+        void finishNmea();
+        void finishUbx();
+        void dispatchNmea(const char* sentence, std::size_t length);
+        void error(GpsParseError err);
+
+    private:
+        enum class State
+        {
+            Idle,
+            NmeaBody,
+            NmeaChecksum1,
+            NmeaChecksum2,
+            UbxSync2,
+            UbxHeader,
+            UbxPayload,
+            UbxChecksum,
+        };
+
+        NmeaListener& m_listener;
+        State m_state;
+        GpsStamp m_stamp;
+        Statistics m_stats;
+
+        // NMEA assembly
+        char m_nmea[MAX_NMEA_LENGTH];
+        std::size_t m_nmea_len;
+        uint8_t m_nmea_xor;
+        uint8_t m_nmea_checksum;
+        bool m_nmea_has_checksum;
+
+        // UBX assembly
+        uint8_t m_ubx_header[4];    // class, id, length
+        uint8_t m_ubx[MAX_UBX_PAYLOAD];
+        std::size_t m_ubx_pos;
+        std::size_t m_ubx_len;
+        uint8_t m_ubx_ck_a;
+        uint8_t m_ubx_ck_b;
+        uint8_t m_ubx_rx_ck_a;
+
+        // raw frame timestamp extension
+        CounterExtender m_raw_sync;
+        CounterExtender m_raw_pps;
+    };
+
+} // trion
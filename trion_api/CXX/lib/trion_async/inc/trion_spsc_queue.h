@@ -0,0 +1,110 @@
+// Copyright (c) DEWETRON GmbH 2026
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace trion
+{
+    /**
+     * Bounded lock-free single producer, single consumer queue.
+     *
+     * Exactly one thread may push and exactly one thread may pop.
+     * The capacity is rounded up to a power of two.
+     */
+    template <typename T>
+    class SpscQueue
+    {
+    public:
+        explicit SpscQueue(std::size_t capacity)
+            : m_head(0)
+            , m_tail(0)
+        {
+            std::size_t size = 2;
+            while (size < capacity)
+            {
+                size <<= 1;
+            }
+            m_buffer.resize(size);
+            m_mask = size - 1;
+        }
+
+        SpscQueue(const SpscQueue&) = delete;
+        SpscQueue& operator=(const SpscQueue&) = delete;
+
+        std::size_t capacity() const
+        {
+            return m_buffer.size();
+        }
+
+        /**
+         * Producer: append one element.
+         * @return false if the queue is full
+         */
+        bool tryPush(const T& value)
+        {
+            const std::size_t tail = m_tail.load(std::memory_order_relaxed);
+            if (tail - m_head.load(std::memory_order_acquire) == m_buffer.size())
+            {
+                return false;
+            }
+            m_buffer[tail & m_mask] = value;
+            m_tail.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * Consumer: remove one element.
+         * @return false if the queue is empty
+         */
+        bool tryPop(T& value)
+        {
+            const std::size_t head = m_head.load(std::memory_order_relaxed);
+            if (head == m_tail.load(std::memory_order_acquire))
+            {
+                return false;
+            }
+            value = m_buffer[head & m_mask];
+            m_head.store(head + 1, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * Consumer: remove up to max_count elements.
+         * @return the number of elements copied to values
+         */
+        std::size_t pop(T* values, std::size_t max_count)
+        {
+            const std::size_t head = m_head.load(std::memory_order_relaxed);
+            std::size_t count = m_tail.load(std::memory_order_acquire) - head;
+            if (count > max_count)
+            {
+                count = max_count;
+            }
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                values[i] = m_buffer[(head + i) & m_mask];
+            }
+            m_head.store(head + count, std::memory_order_release);
+            return count;
+        }
+
+        /**
+         * Approximate number of queued elements.
+         */
+        std::size_t size() const
+        {
+            return m_tail.load(std::memory_order_acquire) - m_head.load(std::memory_order_acquire);
+        }
+
+    private:
+        std::vector<T> m_buffer;
+        std::size_t m_mask;
+
+        // producer and consumer indices on separate cache lines
+        alignas(64) std::atomic<std::size_t> m_head;
+        alignas(64) std::atomic<std::size_t> m_tail;
+    };
+
+} // trion
@@ -0,0 +1,127 @@
+// Copyright (c) DEWETRON GmbH 2026
+#pragma once
+
+#include "dewepxi_types.h"
+#include "trion_counter_extender.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace trion
+{
+    /**
+     * Timestamp side-table entry: the byte at offset and all following
+     * bytes up to the next entry belong to the same run.
+     */
+    struct UartRunStamp
+    {
+        std::size_t offset;         //!< index of the first byte of the run
+        uint64_t sync_counter;      //!< SyncCounter of the first byte
+        uint64_t last_pps;          //!< LastPPS of the first byte
+    };
+
+    /**
+     * Reads UART data via DeWeReadDmaUartRawFrame.
+     *
+     * BOARD_UART_FRAME spends 24 bytes per received data byte. This reader
+     * consumes the packed 8 byte BOARD_UART_RAW_FRAME records in place and
+     * stores the payload as one contiguous byte array plus a sparse timestamp
+     * side-table. A new table entry (run) is started
+     * - for the first byte after clear()
+     * - when LastPPS changes
+     * - when the SyncCounter distance to the previous byte exceeds the
+     *   configured run gap (idle line between two bursts)
+     *
+     * The 32 bit SyncCounter and 24 bit LastPPS are extended to 64 bit.
+     * Frames are returned to the driver in one DeWeFreeDmaUartRawFrame call.
+     */
+    class UartRawReader
+    {
+    public:
+        /**
+         * @param board_no is the board the UART belongs to
+         * @param reserve_bytes is the initial payload capacity
+         */
+        explicit UartRawReader(int board_no, std::size_t reserve_bytes = 65536);
+
+        int getBoardNo() const;
+
+        /**
+         * Start a new run when two consecutive bytes are more than
+         * max_gap SyncCounter ticks apart. 0 disables gap detection.
+         */
+        void setRunGap(uint64_t max_gap);
+        uint64_t getRunGap() const;
+
+        /**
+         * Fetch all available frames from the driver, append them
+         * and free them in bulk.
+         * @param frame_count receives the number of frames read, may be null
+         * @return the API error code
+         */
+        int read(int* frame_count = nullptr);
+
+        /**
+         * Append frames from another source (eg a recorded raw stream).
+         */
+        void append(const BOARD_UART_RAW_FRAME* frames, std::size_t count);
+
+        /**
+         * Drop the collected bytes and runs, keep the counter extension state.
+         */
+        void clear();
+
+        /**
+         * Forget the roll-over state of SyncCounter and LastPPS.
+         * Has to be called when a new acquisition is started.
+         */
+        void resetCounterExtension();
+
+        const uint8_t* data() const;
+        std::size_t size() const;
+
+        const UartRunStamp* runs() const;
+        std::size_t runCount() const;
+
+        /**
+         * Number of bytes of the run with the given index.
+         */
+        std::size_t runLength(std::size_t run) const;
+
+        /**
+         * Find the run containing the byte at offset.
+         * @return the run index or runCount() if offset is out of range
+         */
+        std::size_t findRun(std::size_t offset) const;
+
+        /**
+         * Invoke fn(const uint8_t* data, std::size_t length, const UartRunStamp& stamp)
+         * for every run.
+         */
+        template <typename FN>
+        void forEachRun(FN fn) const
+        {
+            for (std::size_t i = 0; i < m_runs.size(); ++i)
+            {
+                fn(m_data.data() + m_runs[i].offset, runLength(i), m_runs[i]);
+            }
+        }
+
+    private:
+        int m_board_no;
+        uint64_t m_run_gap;
+
+        std::vector<uint8_t> m_data;
+        std::vector<UartRunStamp> m_runs;
+
+        // counter extension state
+        CounterExtender m_sync_counter;
+        CounterExtender m_pps_counter;
+
+        // stamp of the previous byte, used for run detection
+        uint64_t m_prev_sync;
+        uint32_t m_prev_pps;
+        bool m_have_prev;
+    };
+
+} // trion
@@ -0,0 +1,613 @@
+// Copyright (c) DEWETRON GmbH 2026
+
+#include "trion_can_log.h"
+#include "uni_defines.h"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace
+{
+    const char FILE_MAGIC[8] = { 'T', 'R', 'C', 'A', 'N', 'L', 'O', 'G' };
+    const uint32_t FILE_VERSION = 1;
+    const uint32_t CHUNK_MAGIC = 0x4B4E4843;    // "CHNK"
+    const uint32_t INDEX_MAGIC = 0x58444E49;    // "INDX"
+
+    const std::size_t FILE_HEADER_SIZE = 16;
+    const std::size_t CHUNK_HEADER_SIZE = 24;
+    const std::size_t INDEX_ENTRY_SIZE = 44;
+    const std::size_t TRAILER_SIZE = 16;
+
+    const uint32_t MAX_PAYLOAD = 64;
+
+    static_assert(sizeof(BOARD_CAN_FD_FRAME_NG) == 104, "BOARD_CAN_FD_FRAME_NG layout changed");
+
+    // record flag byte
+    const uint8_t FLAG_STD_EXT_MASK = 0x03;
+    const uint8_t FLAG_STD_EXT_ESCAPE = 0x03;
+    const uint8_t FLAG_ERROR_COUNTER = 0x04;
+    const unsigned FLAG_FRAME_TYPE_SHIFT = 3;
+    const uint8_t FLAG_FRAME_TYPE_ESCAPE = 0x1F;
+
+    const uint64_t NS_PER_SECOND = UINT64_VAL(1000000000);
+
+    void putU32(std::vector<uint8_t>& out, uint32_t v)
+    {
+        for (int i = 0; i < 4; ++i)
+        {
+            out.push_back(static_cast<uint8_t>(v >> (8 * i)));
+        }
+    }
+
+    void putU64(std::vector<uint8_t>& out, uint64_t v)
+    {
+        for (int i = 0; i < 8; ++i)
+        {
+            out.push_back(static_cast<uint8_t>(v >> (8 * i)));
+        }
+    }
+
+    void putVarint(std::vector<uint8_t>& out, uint64_t v)
+    {
+        while (v >= 0x80)
+        {
+            out.push_back(static_cast<uint8_t>(v | 0x80));
+            v >>= 7;
+        }
+        out.push_back(static_cast<uint8_t>(v));
+    }
+
+    uint32_t getU32(const uint8_t* p)
+    {
+        return static_cast<uint32_t>(p[0])
+            | (static_cast<uint32_t>(p[1]) << 8)
+            | (static_cast<uint32_t>(p[2]) << 16)
+            | (static_cast<uint32_t>(p[3]) << 24);
+    }
+
+    uint64_t getU64(const uint8_t* p)
+    {
+        return static_cast<uint64_t>(getU32(p)) | (static_cast<uint64_t>(getU32(p + 4)) << 32);
+    }
+
+    uint64_t getVarint(const uint8_t*& p, const uint8_t* end)
+    {
+        uint64_t v = 0;
+        for (unsigned shift = 0; shift < 64; shift += 7)
+        {
+            if (p == end)
+            {
+                break;
+            }
+            uint8_t b = *p++;
+            v |= static_cast<uint64_t>(b & 0x7F) << shift;
+            if ((b & 0x80) == 0)
+            {
+                return v;
+            }
+        }
+        throw std::runtime_error("CanLogReader: truncated record");
+    }
+
+    inline uint64_t zigzagEncode(int64_t v)
+    {
+        return (static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63);
+    }
+
+    inline int64_t zigzagDecode(uint64_t v)
+    {
+        return static_cast<int64_t>(v >> 1) ^ -static_cast<int64_t>(v & 1);
+    }
+
+} // namespace
+
+
+namespace trion
+{
+    uint32_t canPayloadLength(uint32_t data_length)
+    {
+        return std::min(data_length, MAX_PAYLOAD);
+    }
+
+    unsigned canLogIdHash(uint32_t id)
+    {
+        // fibonacci hashing to 6 bit
+        return static_cast<unsigned>((static_cast<uint64_t>(id) * UINT64_VAL(0x9E3779B97F4A7C15)) >> 58);
+    }
+
+
+    CanLogWriter::CanLogWriter(const std::string& file_name, std::size_t chunk_frames)
+        : m_chunk_frames(chunk_frames ? chunk_frames : static_cast<std::size_t>(DEFAULT_CHUNK_FRAMES))
+        , m_chunk_base_ns(0)
+        , m_prev_time_ns(0)
+        , m_prev_error_counter(0)
+        , m_frame_count(0)
+        , m_offset(0)
+    {
+        m_out.open(file_name.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+        if (!m_out)
+        {
+            throw std::runtime_error("CanLogWriter: could not create " + file_name);
+        }
+        std::memset(&m_chunk, 0, sizeof(m_chunk));
+        m_records.reserve(m_chunk_frames * 16);
+
+        m_scratch.assign(FILE_MAGIC, FILE_MAGIC + sizeof(FILE_MAGIC));
+        putU32(m_scratch, FILE_VERSION);
+        putU32(m_scratch, 0);
+        m_out.write(reinterpret_cast<const char*>(m_scratch.data()), m_scratch.size());
+        m_offset = FILE_HEADER_SIZE;
+    }
+
+    CanLogWriter::~CanLogWriter()
+    {
+        try
+        {
+            close();
+        }
+        catch (...)
+        {
+        }
+    }
+
+    void CanLogWriter::write(const BOARD_CAN_FD_FRAME_NG* frames, std::size_t count)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const BOARD_CAN_FD_FRAME_NG& f = frames[i];
+            append(f.TimeStampSeconds * NS_PER_SECOND + f.TimeStampNanoSeconds,
+                f.CanNo, f.MessageId, f.DataLength, f.StandardExtended, f.FrameType, f.ErrorCounter, f.CanData);
+        }
+    }
+
+    void CanLogWriter::write(const BOARD_CAN_FD_FRAME* frames, const int64_t* time_ns, std::size_t count)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const BOARD_CAN_FD_FRAME& f = frames[i];
+            append(static_cast<uint64_t>(time_ns[i]),
+                f.CanNo, f.MessageId, f.DataLength, f.StandardExtended, f.FrameType, f.ErrorCounter, f.CanData);
+        }
+    }
+
+    void CanLogWriter::close()
+    {
+        if (!m_out.is_open())
+        {
+            return;
+        }
+        flushChunk();
+
+        const uint64_t index_offset = m_offset;
+        m_scratch.clear();
+        for (const CanLogChunkInfo& info : m_index)
+        {
+            putU64(m_scratch, info.file_offset);
+            putU64(m_scratch, info.first_time_ns);
+            putU64(m_scratch, info.last_time_ns);
+            putU32(m_scratch, info.min_id);
+            putU32(m_scratch, info.max_id);
+            putU64(m_scratch, info.id_mask);
+            putU32(m_scratch, info.frame_count);
+        }
+        putU64(m_scratch, index_offset);
+        putU32(m_scratch, static_cast<uint32_t>(m_index.size()));
+        putU32(m_scratch, INDEX_MAGIC);
+        m_out.write(reinterpret_cast<const char*>(m_scratch.data()), m_scratch.size());
+        m_offset += m_scratch.size();
+        m_out.close();
+    }
+
+    uint64_t CanLogWriter::getFrameCount() const
+    {
+        return m_frame_count;
+    }
+
+    uint64_t CanLogWriter::getBytesWritten() const
+    {
+        return m_offset;
+    }
+
+    void CanLogWriter::append(uint64_t time_ns, uint8_t can_no, uint32_t id, uint32_t data_length,
+        uint32_t std_ext, uint32_t frame_type, uint32_t error_counter, const uint8_t* data)
+    {
+        if (m_chunk.frame_count == 0)
+        {
+            m_chunk.first_time_ns = time_ns;
+            m_chunk.last_time_ns = time_ns;
+            m_chunk.min_id = id;
+            m_chunk.max_id = id;
+            m_chunk.id_mask = 0;
+            // the first record delta is relative to the chunk base time
+            m_chunk_base_ns = time_ns;
+            m_prev_time_ns = time_ns;
+            m_prev_error_counter = 0;
+        }
+
+        auto it = m_dict_index.find(id);
+        uint32_t dict_idx;
+        if (it == m_dict_index.end())
+        {
+            dict_idx = static_cast<uint32_t>(m_dict.size());
+            m_dict.push_back(id);
+            m_dict_index.emplace(id, dict_idx);
+            m_chunk.id_mask |= UINT64_VAL(1) << canLogIdHash(id);
+            m_chunk.min_id = std::min(m_chunk.min_id, id);
+            m_chunk.max_id = std::max(m_chunk.max_id, id);
+        }
+        else
+        {
+            dict_idx = it->second;
+        }
+
+        const bool error_changed = (error_counter != m_prev_error_counter);
+        uint8_t flags = static_cast<uint8_t>(std_ext < FLAG_STD_EXT_ESCAPE ? std_ext : FLAG_STD_EXT_ESCAPE);
+        if (error_changed)
+        {
+            flags |= FLAG_ERROR_COUNTER;
+        }
+        flags |= static_cast<uint8_t>(std::min<uint32_t>(frame_type, FLAG_FRAME_TYPE_ESCAPE) << FLAG_FRAME_TYPE_SHIFT);
+
+        putVarint(m_records, zigzagEncode(static_cast<int64_t>(time_ns - m_prev_time_ns)));
+        putVarint(m_records, dict_idx);
+        m_records.push_back(can_no);
+        m_records.push_back(flags);
+        if (frame_type >= FLAG_FRAME_TYPE_ESCAPE)
+        {
+            putVarint(m_records, frame_type);
+        }
+        if (std_ext >= FLAG_STD_EXT_ESCAPE)
+        {
+            putVarint(m_records, std_ext);
+        }
+        putVarint(m_records, data_length);
+        if (error_changed)
+        {
+            putVarint(m_records, error_counter);
+        }
+        const uint32_t length = canPayloadLength(data_length);
+        m_records.insert(m_records.end(), data, data + length);
+
+        m_prev_time_ns = time_ns;
+        m_prev_error_counter = error_counter;
+        m_chunk.last_time_ns = std::max(m_chunk.last_time_ns, time_ns);
+        m_chunk.first_time_ns = std::min(m_chunk.first_time_ns, time_ns);
+        ++m_chunk.frame_count;
+        ++m_frame_count;
+
+        if (m_chunk.frame_count >= m_chunk_frames)
+        {
+            flushChunk();
+        }
+    }
+
+    void CanLogWriter::flushChunk()
+    {
+        if (m_chunk.frame_count == 0)
+        {
+            return;
+        }
+        m_chunk.file_offset = m_offset;
+
+        m_scratch.clear();
+        putU32(m_scratch, CHUNK_MAGIC);
+        putU32(m_scratch, m_chunk.frame_count);
+        putU32(m_scratch, static_cast<uint32_t>(m_dict.size()));
+        putU32(m_scratch, static_cast<uint32_t>(m_records.size()));
+        putU64(m_scratch, m_chunk_base_ns);
+        for (uint32_t id : m_dict)
+        {
+            putU32(m_scratch, id);
+        }
+        m_out.write(reinterpret_cast<const char*>(m_scratch.data()), m_scratch.size());
+        m_out.write(reinterpret_cast<const char*>(m_records.data()), m_records.size());
+        if (!m_out)
+        {
+            throw std::runtime_error("CanLogWriter: write failed");
+        }
+        m_offset += m_scratch.size() + m_records.size();
+
+        m_index.push_back(m_chunk);
+        std::memset(&m_chunk, 0, sizeof(m_chunk));
+        m_records.clear();
+        m_dict.clear();
+        m_dict_index.clear();
+    }
+
+
+    void CanLogRecord::toFrame(BOARD_CAN_FD_FRAME_NG& frame) const
+    {
+        frame.Version = CURRENT_CAN_FD_FRAME_NG_VERSION;
+        frame.CanNo = can_no;
+        frame.padding0 = 0;
+        frame.padding1 = 0;
+        frame.MessageId = message_id;
+        frame.DataLength = data_length;
+        frame.StandardExtended = standard_extended;
+        frame.FrameType = frame_type;
+        frame.ErrorCounter = error_counter;
+        frame.TimeStampSeconds = time_ns / NS_PER_SECOND;
+        frame.TimeStampNanoSeconds = static_cast<uint32>(time_ns % NS_PER_SECOND);
+        std::memcpy(frame.CanData, data, payload_size);
+    }
+
+
+    CanLogReader::CanLogReader(const std::string& file_name)
+        : m_recovered(false)
+        , m_pos(nullptr)
+        , m_end(nullptr)
+        , m_remaining(0)
+        , m_time_ns(0)
+        , m_error_counter(0)
+    {
+        m_in.open(file_name.c_str(), std::ios::in | std::ios::binary);
+        if (!m_in)
+        {
+            throw std::runtime_error("CanLogReader: could not open " + file_name);
+        }
+
+        uint8_t header[FILE_HEADER_SIZE];
+        if (!m_in.read(reinterpret_cast<char*>(header), sizeof(header))
+            || std::memcmp(header, FILE_MAGIC, sizeof(FILE_MAGIC)) != 0
+            || getU32(header + 8) != FILE_VERSION)
+        {
+            throw std::runtime_error("CanLogReader: no CAN log file " + file_name);
+        }
+
+        m_in.seekg(0, std::ios::end);
+        const uint64_t file_size = static_cast<uint64_t>(m_in.tellg());
+        if (!readIndex(file_size))
+        {
+            recoverIndex(file_size);
+        }
+    }
+
+    bool CanLogReader::isRecovered() const
+    {
+        return m_recovered;
+    }
+
+    bool CanLogReader::readIndex(uint64_t file_size)
+    {
+        if (file_size < FILE_HEADER_SIZE + TRAILER_SIZE)
+        {
+            return false;
+        }
+        uint8_t trailer[TRAILER_SIZE];
+        m_in.clear();
+        m_in.seekg(static_cast<std::streamoff>(file_size - TRAILER_SIZE), std::ios::beg);
+        if (!m_in.read(reinterpret_cast<char*>(trailer), sizeof(trailer))
+            || getU32(trailer + 12) != INDEX_MAGIC)
+        {
+            return false;
+        }
+        const uint64_t index_offset = getU64(trailer);
+        const uint32_t chunk_count = getU32(trailer + 8);
+        if (index_offset + static_cast<uint64_t>(chunk_count) * INDEX_ENTRY_SIZE + TRAILER_SIZE != file_size)
+        {
+            return false;
+        }
+
+        std::vector<uint8_t> index(static_cast<std::size_t>(chunk_count) * INDEX_ENTRY_SIZE);
+        m_in.seekg(static_cast<std::streamoff>(index_offset), std::ios::beg);
+        if (!m_in.read(reinterpret_cast<char*>(index.data()), index.size()))
+        {
+            return false;
+        }
+        m_index.resize(chunk_count);
+        for (uint32_t i = 0; i < chunk_count; ++i)
+        {
+            const uint8_t* p = index.data() + i * INDEX_ENTRY_SIZE;
+            CanLogChunkInfo& info = m_index[i];
+            info.file_offset = getU64(p);
+            info.first_time_ns = getU64(p + 8);
+            info.last_time_ns = getU64(p + 16);
+            info.min_id = getU32(p + 24);
+            info.max_id = getU32(p + 28);
+            info.id_mask = getU64(p + 32);
+            info.frame_count = getU32(p + 40);
+        }
+        return true;
+    }
+
+    void CanLogReader::recoverIndex(uint64_t file_size)
+    {
+        m_recovered = true;
+        m_index.clear();
+
+        // the writer appends complete chunks only, so everything before the
+        // first incomplete or corrupt chunk is valid
+        uint64_t offset = FILE_HEADER_SIZE;
+        while (offset + CHUNK_HEADER_SIZE <= file_size)
+        {
+            uint8_t header[CHUNK_HEADER_SIZE];
+            m_in.clear();
+            m_in.seekg(static_cast<std::streamoff>(offset), std::ios::beg);
+            if (!m_in.read(reinterpret_cast<char*>(header), sizeof(header))
+                || getU32(header) != CHUNK_MAGIC)
+            {
+                break;
+            }
+            const uint64_t chunk_size = CHUNK_HEADER_SIZE
+                + static_cast<uint64_t>(getU32(header + 8)) * 4 + getU32(header + 12);
+            if (offset + chunk_size > file_size)
+            {
+                break;
+            }
+
+            CanLogChunkInfo info;
+            std::memset(&info, 0, sizeof(info));
+            info.file_offset = offset;
+            m_index.push_back(info);
+            try
+            {
+                loadChunk(m_index.size() - 1);
+                CanLogChunkInfo& entry = m_index.back();
+                for (uint32_t id : m_dict)
+                {
+                    entry.id_mask |= UINT64_VAL(1) << canLogIdHash(id);
+                }
+                if (!m_dict.empty())
+                {
+                    entry.min_id = *std::min_element(m_dict.begin(), m_dict.end());
+                    entry.max_id = *std::max_element(m_dict.begin(), m_dict.end());
+                }
+                CanLogRecord record;
+                while (nextRecord(record))
+                {
+                    if (entry.frame_count == 0)
+                    {
+                        entry.first_time_ns = record.time_ns;
+                        entry.last_time_ns = record.time_ns;
+                    }
+                    entry.first_time_ns = std::min(entry.first_time_ns, record.time_ns);
+                    entry.last_time_ns = std::max(entry.last_time_ns, record.time_ns);
+                    ++entry.frame_count;
+                }
+                if (m_pos != m_end)
+                {
+                    throw std::runtime_error("CanLogReader: corrupt chunk");
+                }
+            }
+            catch (const std::runtime_error&)
+            {
+                m_index.pop_back();
+                break;
+            }
+            offset += chunk_size;
+        }
+        m_remaining = 0;
+    }
+
+    std::size_t CanLogReader::getChunkCount() const
+    {
+        return m_index.size();
+    }
+
+    const CanLogChunkInfo& CanLogReader::getChunkInfo(std::size_t chunk) const
+    {
+        return m_index.at(chunk);
+    }
+
+    std::size_t CanLogReader::findChunk(uint64_t time_ns) const
+    {
+        for (std::size_t i = 0; i < m_index.size(); ++i)
+        {
+            if (m_index[i].last_time_ns >= time_ns)
+            {
+                return i;
+            }
+        }
+        return m_index.size();
+    }
+
+    bool CanLogReader::mayContainId(std::size_t chunk, uint32_t id) const
+    {
+        const CanLogChunkInfo& info = m_index.at(chunk);
+        return id >= info.min_id
+            && id <= info.max_id
+            && (info.id_mask & (UINT64_VAL(1) << canLogIdHash(id))) != 0;
+    }
+
+    void CanLogReader::loadChunk(std::size_t chunk)
+    {
+        const CanLogChunkInfo& info = m_index.at(chunk);
+
+        uint8_t header[CHUNK_HEADER_SIZE];
+        m_in.clear();
+        m_in.seekg(static_cast<std::streamoff>(info.file_offset), std::ios::beg);
+        if (!m_in.read(reinterpret_cast<char*>(header), sizeof(header))
+            || getU32(header) != CHUNK_MAGIC)
+        {
+            throw std::runtime_error("CanLogReader: corrupt chunk");
+        }
+        const uint32_t frame_count = getU32(header + 4);
+        const uint32_t dict_count = getU32(header + 8);
+        const uint32_t records_size = getU32(header + 12);
+
+        m_buffer.resize(static_cast<std::size_t>(dict_count) * 4 + records_size);
+        if (!m_in.read(reinterpret_cast<char*>(m_buffer.data()), m_buffer.size()))
+        {
+            throw std::runtime_error("CanLogReader: truncated chunk");
+        }
+        m_dict.resize(dict_count);
+        for (uint32_t i = 0; i < dict_count; ++i)
+        {
+            m_dict[i] = getU32(m_buffer.data() + i * 4);
+        }
+        m_pos = m_buffer.data() + static_cast<std::size_t>(dict_count) * 4;
+        m_end = m_buffer.data() + m_buffer.size();
+        m_remaining = frame_count;
+        m_time_ns = getU64(header + 16);
+        m_error_counter = 0;
+    }
+
+    bool CanLogReader::nextRecord(CanLogRecord& record)
+    {
+        if (m_remaining == 0)
+        {
+            return false;
+        }
+        const uint8_t* p = m_pos;
+        m_time_ns += static_cast<uint64_t>(zigzagDecode(getVarint(p, m_end)));
+        const uint64_t dict_idx = getVarint(p, m_end);
+        if (dict_idx >= m_dict.size() || m_end - p < 2)
+        {
+            throw std::runtime_error("CanLogReader: corrupt record");
+        }
+        record.time_ns = m_time_ns;
+        record.message_id = m_dict[static_cast<std::size_t>(dict_idx)];
+        record.can_no = *p++;
+        const uint8_t flags = *p++;
+
+        record.frame_type = flags >> FLAG_FRAME_TYPE_SHIFT;
+        if (record.frame_type == FLAG_FRAME_TYPE_ESCAPE)
+        {
+            record.frame_type = static_cast<uint32_t>(getVarint(p, m_end));
+        }
+        record.standard_extended = flags & FLAG_STD_EXT_MASK;
+        if (record.standard_extended == FLAG_STD_EXT_ESCAPE)
+        {
+            record.standard_extended = static_cast<uint32_t>(getVarint(p, m_end));
+        }
+        record.data_length = static_cast<uint32_t>(getVarint(p, m_end));
+        if (flags & FLAG_ERROR_COUNTER)
+        {
+            m_error_counter = static_cast<uint32_t>(getVarint(p, m_end));
+        }
+        record.error_counter = m_error_counter;
+        record.payload_size = canPayloadLength(record.data_length);
+        if (static_cast<std::size_t>(m_end - p) < record.payload_size)
+        {
+            throw std::runtime_error("CanLogReader: truncated record");
+        }
+        record.data = p;
+        m_pos = p + record.payload_size;
+        --m_remaining;
+        return true;
+    }
+
+    void CanLogReader::readChunk(std::size_t chunk, std::vector<BOARD_CAN_FD_FRAME_NG>& frames, int64_t id_filter)
+    {
+        frames.clear();
+        if (id_filter >= 0 && !mayContainId(chunk, static_cast<uint32_t>(id_filter)))
+        {
+            return;
+        }
+        loadChunk(chunk);
+        frames.reserve(m_remaining);
+
+        CanLogRecord record;
+        while (nextRecord(record))
+        {
+            if (id_filter >= 0 && record.message_id != static_cast<uint32_t>(id_filter))
+            {
+                continue;
+            }
+            // value initialized, CanData beyond the payload stays zero
+            frames.emplace_back();
+            record.toFrame(frames.back());
+        }
+    }
+
+} // trion
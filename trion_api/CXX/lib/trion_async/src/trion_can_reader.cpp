@@ -0,0 +1,348 @@
+// Copyright (c) DEWETRON GmbH 2026
+
+#include "trion_can_reader.h"
+#include "dewepxi_apicore.h"
+#include <chrono>
+#include <stdexcept>
+
+#if defined(WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace
+{
+    // frame rate measurement window
+    const std::chrono::milliseconds RATE_WINDOW(1000);
+
+    // only retune if the recommendation differs by this factor
+    const double RETUNE_HYSTERESIS = 1.5;
+
+    void pinCurrentThread(int cpu_core)
+    {
+        if (cpu_core < 0)
+        {
+            return;
+        }
+#if defined(WIN32)
+        SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR(1) << cpu_core);
+#elif defined(__linux__)
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpu_core, &set);
+        pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#endif
+    }
+
+} // namespace
+
+
+namespace trion
+{
+    CanSubscription::CanSubscription(const CanFilter& filter, std::size_t capacity)
+        : m_filter(filter)
+        , m_queue(capacity)
+        , m_dropped(0)
+    {
+    }
+
+    const CanFilter& CanSubscription::getFilter() const
+    {
+        return m_filter;
+    }
+
+    std::size_t CanSubscription::pop(BOARD_CAN_FD_FRAME* frames, std::size_t max_count)
+    {
+        return m_queue.pop(frames, max_count);
+    }
+
+    std::size_t CanSubscription::available() const
+    {
+        return m_queue.size();
+    }
+
+    uint64_t CanSubscription::getDropped() const
+    {
+        return m_dropped.load(std::memory_order_relaxed);
+    }
+
+
+    struct CanReaderService::Board
+    {
+        BoardConfig config;
+        std::vector<CanSubscriptionPtr> subscriptions;
+        std::thread thread;
+
+        std::atomic<uint64_t> frames;
+        std::atomic<uint64_t> polls;
+        std::atomic<uint64_t> errors;
+        std::atomic<int> last_error;
+        std::atomic<double> frame_rate;
+        std::atomic<int> polling_time_ms;
+        std::atomic<int> recommended_polling_time_ms;
+
+        explicit Board(const BoardConfig& cfg)
+            : config(cfg)
+            , frames(0)
+            , polls(0)
+            , errors(0)
+            , last_error(ERR_NONE)
+            , frame_rate(0)
+            , polling_time_ms(cfg.polling_time_ms)
+            , recommended_polling_time_ms(cfg.polling_time_ms)
+        {
+        }
+    };
+
+
+    CanReaderService::CanReaderService()
+        : m_running(false)
+        , m_auto_tune(false)
+    {
+    }
+
+    CanReaderService::~CanReaderService()
+    {
+        stop();
+    }
+
+    void CanReaderService::addBoard(const BoardConfig& config)
+    {
+        if (m_running)
+        {
+            throw std::runtime_error("CanReaderService: addBoard while running");
+        }
+        if (findBoard(config.board_no))
+        {
+            throw std::runtime_error("CanReaderService: board already added");
+        }
+        m_boards.push_back(std::unique_ptr<Board>(new Board(config)));
+    }
+
+    CanSubscriptionPtr CanReaderService::subscribe(int board_no, int port, std::size_t capacity)
+    {
+        return subscribe(board_no, port, 0, 0xFFFFFFFF, capacity);
+    }
+
+    CanSubscriptionPtr CanReaderService::subscribe(int board_no, int port, uint32_t id_min, uint32_t id_max, std::size_t capacity)
+    {
+        if (m_running)
+        {
+            throw std::runtime_error("CanReaderService: subscribe while running");
+        }
+        Board* board = findBoard(board_no);
+        if (!board)
+        {
+            throw std::runtime_error("CanReaderService: unknown board");
+        }
+        CanFilter filter;
+        filter.board_no = board_no;
+        filter.port = port;
+        filter.id_min = id_min;
+        filter.id_max = id_max;
+
+        auto sub = std::make_shared<CanSubscription>(filter, capacity);
+        board->subscriptions.push_back(sub);
+        return sub;
+    }
+
+    void CanReaderService::setAutoTune(bool enable)
+    {
+        m_auto_tune = enable;
+    }
+
+    bool CanReaderService::getAutoTune() const
+    {
+        return m_auto_tune;
+    }
+
+    int CanReaderService::configure()
+    {
+        if (m_running)
+        {
+            throw std::runtime_error("CanReaderService: configure while running");
+        }
+        for (auto& board : m_boards)
+        {
+            const int polling_time_ms = m_auto_tune ? board->recommended_polling_time_ms.load() : board->config.polling_time_ms;
+            int err = DeWeSetParam_i32(board->config.board_no, CMD_ASYNC_POLLING_TIME, polling_time_ms);
+            if (err != ERR_NONE)
+            {
+                return err;
+            }
+            err = DeWeSetParam_i32(board->config.board_no, CMD_ASYNC_FRAME_SIZE, board->config.frame_size);
+            if (err != ERR_NONE)
+            {
+                return err;
+            }
+            board->polling_time_ms = polling_time_ms;
+            board->recommended_polling_time_ms = polling_time_ms;
+        }
+        return ERR_NONE;
+    }
+
+    void CanReaderService::start()
+    {
+        if (m_running.exchange(true))
+        {
+            return;
+        }
+        for (auto& board : m_boards)
+        {
+            Board* b = board.get();
+            b->thread = std::thread([this, b]() { readerLoop(*b); });
+        }
+    }
+
+    void CanReaderService::stop()
+    {
+        if (!m_running.exchange(false))
+        {
+            return;
+        }
+        for (auto& board : m_boards)
+        {
+            if (board->thread.joinable())
+            {
+                board->thread.join();
+            }
+        }
+    }
+
+    bool CanReaderService::isRunning() const
+    {
+        return m_running;
+    }
+
+    CanReaderService::BoardStatistics CanReaderService::getStatistics(int board_no) const
+    {
+        BoardStatistics stats = {};
+        Board* board = findBoard(board_no);
+        if (board)
+        {
+            stats.frames = board->frames;
+            stats.polls = board->polls;
+            stats.errors = board->errors;
+            stats.last_error = board->last_error;
+            stats.frame_rate = board->frame_rate;
+            stats.polling_time_ms = board->polling_time_ms;
+            stats.recommended_polling_time_ms = board->recommended_polling_time_ms;
+        }
+        return stats;
+    }
+
+    int CanReaderService::recommendPollingTime(double frame_rate)
+    {
+        if (frame_rate <= 0)
+        {
+            return MAX_POLLING_TIME_MS;
+        }
+        double ms = 1000.0 * TARGET_FRAMES_PER_POLL / frame_rate;
+        if (ms < MIN_POLLING_TIME_MS)
+        {
+            return MIN_POLLING_TIME_MS;
+        }
+        if (ms > MAX_POLLING_TIME_MS)
+        {
+            return MAX_POLLING_TIME_MS;
+        }
+        return static_cast<int>(ms + 0.5);
+    }
+
+    void CanReaderService::readerLoop(Board& board)
+    {
+        typedef std::chrono::steady_clock Clock;
+
+        pinCurrentThread(board.config.cpu_core);
+
+        const int board_no = board.config.board_no;
+        std::vector<BOARD_CAN_FD_FRAME> frames(READ_BATCH);
+        std::vector<CanSubscription*> subs;
+        for (auto& sub : board.subscriptions)
+        {
+            subs.push_back(sub.get());
+        }
+
+        Clock::time_point window_start = Clock::now();
+        uint64_t window_frames = 0;
+
+        while (m_running.load(std::memory_order_relaxed))
+        {
+            int count = 0;
+            int err = DeWeReadCANEx(board_no, frames.data(), READ_BATCH, &count);
+            board.polls.fetch_add(1, std::memory_order_relaxed);
+            if (err != ERR_NONE)
+            {
+                board.errors.fetch_add(1, std::memory_order_relaxed);
+                board.last_error = err;
+                count = 0;
+            }
+
+            for (int i = 0; i < count; ++i)
+            {
+                const BOARD_CAN_FD_FRAME& frame = frames[i];
+                for (CanSubscription* sub : subs)
+                {
+                    if (sub->m_filter.matches(frame) && !sub->m_queue.tryPush(frame))
+                    {
+                        sub->m_dropped.fetch_add(1, std::memory_order_relaxed);
+                    }
+                }
+            }
+            board.frames.fetch_add(count, std::memory_order_relaxed);
+            window_frames += count;
+
+            Clock::time_point now = Clock::now();
+            if (now - window_start >= RATE_WINDOW)
+            {
+                double seconds = std::chrono::duration<double>(now - window_start).count();
+                double rate = window_frames / seconds;
+                board.frame_rate = rate;
+                if (m_auto_tune)
+                {
+                    autoTune(board, rate);
+                }
+                window_start = now;
+                window_frames = 0;
+            }
+
+            // a full batch means more frames are pending: read again immediately
+            if (count < READ_BATCH)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(board.polling_time_ms / 2 + 1));
+            }
+        }
+    }
+
+    void CanReaderService::autoTune(Board& board, double frame_rate)
+    {
+        // only a recommendation: an update command while CAN is running would
+        // reprogram the channel and race with the configuration of the owner
+        const int current = board.polling_time_ms;
+        const int recommended = recommendPollingTime(frame_rate);
+        if (recommended * RETUNE_HYSTERESIS > current && recommended < current * RETUNE_HYSTERESIS)
+        {
+            board.recommended_polling_time_ms = current;
+            return;
+        }
+        board.recommended_polling_time_ms = recommended;
+    }
+
+    CanReaderService::Board* CanReaderService::findBoard(int board_no) const
+    {
+        for (auto& board : m_boards)
+        {
+            if (board->config.board_no == board_no)
+            {
+                return board.get();
+            }
+        }
+        return nullptr;
+    }
+
+} // trion
@@ -0,0 +1,272 @@
+// Copyright (c) DEWETRON GmbH 2026
+
+#include "trion_can_timestamp.h"
+#include "uni_defines.h"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    const double NS_PER_SECOND = 1e9;
+    const double TICKS_10MHZ_PER_SECOND = 1e7;
+
+    // frames are converted in chunks to keep the counter buffer on the stack
+    const std::size_t CHUNK_SIZE = 256;
+
+    inline int64_t roundToInt64(double value)
+    {
+        return static_cast<int64_t>(std::floor(value + 0.5));
+    }
+
+} // namespace
+
+
+namespace trion
+{
+    CanTimestampConverter::CanTimestampConverter(double sample_rate, CanSyncCounterMode mode)
+        : m_sample_rate(sample_rate)
+        , m_mode(mode)
+        , m_use_sync_counter_ex(true)
+        , m_ns_per_count(0)
+        , m_samples_per_count(0)
+        , m_samples_per_ns(0)
+        , m_ng_origin_sec(0)
+        , m_ng_origin_nsec(0)
+        , m_sync_counter()
+    {
+        updateFactors();
+    }
+
+    void CanTimestampConverter::setSampleRate(double sample_rate)
+    {
+        m_sample_rate = sample_rate;
+        updateFactors();
+    }
+
+    double CanTimestampConverter::getSampleRate() const
+    {
+        return m_sample_rate;
+    }
+
+    void CanTimestampConverter::setSyncCounterMode(CanSyncCounterMode mode)
+    {
+        m_mode = mode;
+        updateFactors();
+    }
+
+    CanSyncCounterMode CanTimestampConverter::getSyncCounterMode() const
+    {
+        return m_mode;
+    }
+
+    void CanTimestampConverter::setUseSyncCounterEx(bool use_ex)
+    {
+        m_use_sync_counter_ex = use_ex;
+    }
+
+    bool CanTimestampConverter::getUseSyncCounterEx() const
+    {
+        return m_use_sync_counter_ex;
+    }
+
+    void CanTimestampConverter::setNgTimeOrigin(uint64_t seconds, uint32_t nanoseconds)
+    {
+        m_ng_origin_sec = seconds;
+        m_ng_origin_nsec = nanoseconds;
+    }
+
+    void CanTimestampConverter::resetSyncCounterExtension()
+    {
+        m_sync_counter.reset();
+    }
+
+    uint64_t CanTimestampConverter::extendSyncCounter(uint32_t sync_counter)
+    {
+        return m_sync_counter.extend(sync_counter);
+    }
+
+    int64_t CanTimestampConverter::counterToNanoseconds(uint64_t counter) const
+    {
+        if (m_mode == CanSyncCounterMode::Count10MHz)
+        {
+            // exact: one tick is 100ns
+            return static_cast<int64_t>(counter) * 100;
+        }
+        return roundToInt64(static_cast<double>(counter) * m_ns_per_count);
+    }
+
+    double CanTimestampConverter::counterToSampleIndex(uint64_t counter) const
+    {
+        return static_cast<double>(counter) * m_samples_per_count;
+    }
+
+    int64_t CanTimestampConverter::ngTimeToNanoseconds(uint64_t seconds, uint32_t nanoseconds) const
+    {
+        return static_cast<int64_t>(seconds - m_ng_origin_sec) * SINT64_VAL(1000000000)
+            + (static_cast<int64_t>(nanoseconds) - static_cast<int64_t>(m_ng_origin_nsec));
+    }
+
+    double CanTimestampConverter::nanosecondsToSampleIndex(int64_t ns) const
+    {
+        return static_cast<double>(ns) * m_samples_per_ns;
+    }
+
+    void CanTimestampConverter::countersToNanoseconds(const uint64_t* counters, std::size_t count, int64_t* ns) const
+    {
+        const uint64_t* UNI_RESTRICT src = counters;
+        int64_t* UNI_RESTRICT dst = ns;
+
+        if (m_mode == CanSyncCounterMode::Count10MHz)
+        {
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                dst[i] = static_cast<int64_t>(src[i]) * 100;
+            }
+        }
+        else
+        {
+            const double factor = m_ns_per_count;
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                dst[i] = roundToInt64(static_cast<double>(src[i]) * factor);
+            }
+        }
+    }
+
+    void CanTimestampConverter::countersToSampleIndex(const uint64_t* counters, std::size_t count, double* index) const
+    {
+        const uint64_t* UNI_RESTRICT src = counters;
+        double* UNI_RESTRICT dst = index;
+        const double factor = m_samples_per_count;
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            dst[i] = static_cast<double>(src[i]) * factor;
+        }
+    }
+
+    void CanTimestampConverter::nanosecondsToSampleIndex(const int64_t* ns, std::size_t count, double* index) const
+    {
+        const int64_t* UNI_RESTRICT src = ns;
+        double* UNI_RESTRICT dst = index;
+        const double factor = m_samples_per_ns;
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            dst[i] = static_cast<double>(src[i]) * factor;
+        }
+    }
+
+    void CanTimestampConverter::toNanoseconds(const BOARD_CAN_FRAME* frames, std::size_t count, int64_t* ns)
+    {
+        uint64_t counters[CHUNK_SIZE];
+        for (std::size_t pos = 0; pos < count; pos += CHUNK_SIZE)
+        {
+            std::size_t n = std::min(CHUNK_SIZE, count - pos);
+            loadCounters(frames + pos, n, counters);
+            countersToNanoseconds(counters, n, ns + pos);
+        }
+    }
+
+    void CanTimestampConverter::toNanoseconds(const BOARD_CAN_FD_FRAME* frames, std::size_t count, int64_t* ns)
+    {
+        uint64_t counters[CHUNK_SIZE];
+        for (std::size_t pos = 0; pos < count; pos += CHUNK_SIZE)
+        {
+            std::size_t n = std::min(CHUNK_SIZE, count - pos);
+            loadCounters(frames + pos, n, counters);
+            countersToNanoseconds(counters, n, ns + pos);
+        }
+    }
+
+    void CanTimestampConverter::toNanoseconds(const BOARD_CAN_FD_FRAME_NG* frames, std::size_t count, int64_t* ns) const
+    {
+        const int64_t origin_ns = static_cast<int64_t>(m_ng_origin_nsec);
+        const uint64_t origin_sec = m_ng_origin_sec;
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            ns[i] = static_cast<int64_t>(frames[i].TimeStampSeconds - origin_sec) * SINT64_VAL(1000000000)
+                + (static_cast<int64_t>(frames[i].TimeStampNanoSeconds) - origin_ns);
+        }
+    }
+
+    void CanTimestampConverter::toSampleIndex(const BOARD_CAN_FRAME* frames, std::size_t count, double* index)
+    {
+        uint64_t counters[CHUNK_SIZE];
+        for (std::size_t pos = 0; pos < count; pos += CHUNK_SIZE)
+        {
+            std::size_t n = std::min(CHUNK_SIZE, count - pos);
+            loadCounters(frames + pos, n, counters);
+            countersToSampleIndex(counters, n, index + pos);
+        }
+    }
+
+    void CanTimestampConverter::toSampleIndex(const BOARD_CAN_FD_FRAME* frames, std::size_t count, double* index)
+    {
+        uint64_t counters[CHUNK_SIZE];
+        for (std::size_t pos = 0; pos < count; pos += CHUNK_SIZE)
+        {
+            std::size_t n = std::min(CHUNK_SIZE, count - pos);
+            loadCounters(frames + pos, n, counters);
+            countersToSampleIndex(counters, n, index + pos);
+        }
+    }
+
+    void CanTimestampConverter::toSampleIndex(const BOARD_CAN_FD_FRAME_NG* frames, std::size_t count, double* index) const
+    {
+        int64_t ns[CHUNK_SIZE];
+        for (std::size_t pos = 0; pos < count; pos += CHUNK_SIZE)
+        {
+            std::size_t n = std::min(CHUNK_SIZE, count - pos);
+            toNanoseconds(frames + pos, n, ns);
+            nanosecondsToSampleIndex(ns, n, index + pos);
+        }
+    }
+
+    template <typename FRAME>
+    void CanTimestampConverter::loadCounters(const FRAME* frames, std::size_t count, uint64_t* counters)
+    {
+        if (m_use_sync_counter_ex)
+        {
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                counters[i] = frames[i].SyncCounterEx;
+            }
+        }
+        else
+        {
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                counters[i] = extendSyncCounter(frames[i].SyncCounter);
+            }
+        }
+    }
+
+    void CanTimestampConverter::updateFactors()
+    {
+        if (m_sample_rate <= 0)
+        {
+            m_ns_per_count = 0;
+            m_samples_per_count = 0;
+            m_samples_per_ns = 0;
+            return;
+        }
+
+        m_samples_per_ns = m_sample_rate / NS_PER_SECOND;
+
+        switch (m_mode)
+        {
+        case CanSyncCounterMode::Count10MHz:
+            m_ns_per_count = NS_PER_SECOND / TICKS_10MHZ_PER_SECOND;
+            m_samples_per_count = m_sample_rate / TICKS_10MHZ_PER_SECOND;
+            break;
+        case CanSyncCounterMode::SampleCount:
+        default:
+            m_ns_per_count = NS_PER_SECOND / m_sample_rate;
+            m_samples_per_count = 1.0;
+            break;
+        }
+    }
+
+} // trion
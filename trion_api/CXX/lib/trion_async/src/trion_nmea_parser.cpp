@@ -0,0 +1,672 @@
+// Copyright (c) DEWETRON GmbH 2026
+
+#include "trion_nmea_parser.h"
+#include "uni_defines.h"
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace
+{
+    const uint8_t UBX_SYNC_1 = 0xB5;
+    const uint8_t UBX_SYNC_2 = 0x62;
+
+    const uint8_t HEX_INVALID = 0xFF;
+
+    /**
+     * Hex digit lookup table for the NMEA checksum
+     */
+    struct HexTable
+    {
+        uint8_t value[256];
+
+        HexTable()
+        {
+            std::memset(value, HEX_INVALID, sizeof(value));
+            for (int i = 0; i < 10; ++i)
+            {
+                value['0' + i] = static_cast<uint8_t>(i);
+            }
+            for (int i = 0; i < 6; ++i)
+            {
+                value['A' + i] = static_cast<uint8_t>(10 + i);
+                value['a' + i] = static_cast<uint8_t>(10 + i);
+            }
+        }
+    };
+
+    const HexTable HEX_TABLE;
+
+    const double NaN = std::numeric_limits<double>::quiet_NaN();
+
+    /**
+     * Fraction digits kept by parseDouble, more are below double precision
+     */
+    const int MAX_FRACTION_DIGITS = 18;
+
+    /**
+     * Non owning view of one comma separated NMEA field
+     */
+    struct Field
+    {
+        const char* begin;
+        const char* end;
+
+        bool empty() const { return begin == end; }
+        char first() const { return empty() ? 0 : *begin; }
+    };
+
+    /**
+     * Splits a sentence into fields without copying
+     */
+    class FieldReader
+    {
+    public:
+        FieldReader(const char* sentence, std::size_t length)
+            : m_pos(sentence)
+            , m_end(sentence + length)
+            , m_done(false)
+        {
+        }
+
+        bool next(Field& field)
+        {
+            if (m_done)
+            {
+                return false;
+            }
+            field.begin = m_pos;
+            while (m_pos != m_end && *m_pos != ',')
+            {
+                ++m_pos;
+            }
+            field.end = m_pos;
+            if (m_pos == m_end)
+            {
+                m_done = true;
+            }
+            else
+            {
+                ++m_pos;
+            }
+            return true;
+        }
+
+        /**
+         * Returns an empty field when the sentence has no more fields
+         */
+        Field next()
+        {
+            Field f;
+            if (!next(f))
+            {
+                f.begin = f.end = m_end;
+            }
+            return f;
+        }
+
+    private:
+        const char* m_pos;
+        const char* m_end;
+        bool m_done;
+    };
+
+    bool parseUint(const char* begin, const char* end, uint32_t& value)
+    {
+        if (begin == end)
+        {
+            return false;
+        }
+        uint32_t v = 0;
+        for (const char* p = begin; p != end; ++p)
+        {
+            unsigned digit = static_cast<unsigned>(*p - '0');
+            if (digit > 9)
+            {
+                return false;
+            }
+            v = v * 10 + digit;
+        }
+        value = v;
+        return true;
+    }
+
+    /**
+     * Locale independent decimal number parser, NaN for empty or malformed fields.
+     */
+    double parseDouble(const Field& f)
+    {
+        const char* p = f.begin;
+        if (p == f.end)
+        {
+            return NaN;
+        }
+        bool negative = false;
+        if (*p == '-' || *p == '+')
+        {
+            negative = (*p == '-');
+            ++p;
+        }
+        int64_t mantissa = 0;
+        int frac_digits = 0;
+        bool in_fraction = false;
+        bool have_digit = false;
+        for (; p != f.end; ++p)
+        {
+            if (*p == '.' && !in_fraction)
+            {
+                in_fraction = true;
+                continue;
+            }
+            unsigned digit = static_cast<unsigned>(*p - '0');
+            if (digit > 9)
+            {
+                return NaN;
+            }
+            have_digit = true;
+            // NMEA numbers never exceed the int64 range, guard anyway, and
+            // drop fraction digits beyond the POW10 table
+            if (in_fraction && frac_digits == MAX_FRACTION_DIGITS)
+            {
+                continue;
+            }
+            if (mantissa < SINT64_VAL(100000000000000000))
+            {
+                mantissa = mantissa * 10 + digit;
+                if (in_fraction)
+                {
+                    ++frac_digits;
+                }
+            }
+            else if (!in_fraction)
+            {
+                return NaN;
+            }
+        }
+        if (!have_digit)
+        {
+            return NaN;
+        }
+        static const double POW10[MAX_FRACTION_DIGITS + 1] = {
+            1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9,
+            1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18 };
+        double value = static_cast<double>(mantissa) / POW10[frac_digits];
+        return negative ? -value : value;
+    }
+
+    template <typename T>
+    T parseInt(const Field& f, T default_value)
+    {
+        uint32_t v;
+        if (!parseUint(f.begin, f.end, v))
+        {
+            return default_value;
+        }
+        return static_cast<T>(v);
+    }
+
+    /**
+     * hhmmss[.sss]
+     */
+    trion::NmeaUtcTime parseTime(const Field& f)
+    {
+        trion::NmeaUtcTime t = {};
+        uint32_t hh, mm, ss;
+        if (f.end - f.begin < 6
+            || !parseUint(f.begin, f.begin + 2, hh)
+            || !parseUint(f.begin + 2, f.begin + 4, mm)
+            || !parseUint(f.begin + 4, f.begin + 6, ss))
+        {
+            return t;
+        }
+        t.hour = static_cast<uint8_t>(hh);
+        t.minute = static_cast<uint8_t>(mm);
+        t.second = static_cast<uint8_t>(ss);
+
+        const char* p = f.begin + 6;
+        if (p != f.end && *p == '.')
+        {
+            ++p;
+            // milliseconds from up to three fractional digits
+            uint32_t ms = 0;
+            int digits = 0;
+            for (; p != f.end && digits < 3; ++p, ++digits)
+            {
+                unsigned digit = static_cast<unsigned>(*p - '0');
+                if (digit > 9)
+                {
+                    return t;
+                }
+                ms = ms * 10 + digit;
+            }
+            for (; digits < 3; ++digits)
+            {
+                ms *= 10;
+            }
+            t.millisecond = static_cast<uint16_t>(ms);
+        }
+        t.valid = true;
+        return t;
+    }
+
+    /**
+     * (d)ddmm.mmmm plus hemisphere to signed decimal degrees
+     */
+    double parseCoordinate(const Field& value, const Field& hemisphere)
+    {
+        double raw = parseDouble(value);
+        if (std::isnan(raw))
+        {
+            return NaN;
+        }
+        double degrees = std::floor(raw / 100.0);
+        double result = degrees + (raw - degrees * 100.0) / 60.0;
+        char h = hemisphere.first();
+        if (h == 'S' || h == 'W')
+        {
+            result = -result;
+        }
+        return result;
+    }
+
+    void copyTalker(char* talker, const char* sentence)
+    {
+        // sentence starts with "$TTSSS"
+        talker[0] = sentence[1];
+        talker[1] = sentence[2];
+        talker[2] = 0;
+    }
+
+} // namespace
+
+
+namespace trion
+{
+    NmeaStreamParser::NmeaStreamParser(NmeaListener& listener)
+        : m_listener(listener)
+        , m_raw_sync()
+        , m_raw_pps(0x00FFFFFF)
+    {
+        reset();
+    }
+
+    void NmeaStreamParser::reset()
+    {
+        m_state = State::Idle;
+        m_stamp.sync_counter = 0;
+        m_stamp.last_pps = 0;
+        std::memset(&m_stats, 0, sizeof(m_stats));
+        m_nmea_len = 0;
+        m_nmea_xor = 0;
+        m_nmea_checksum = 0;
+        m_nmea_has_checksum = false;
+        m_ubx_pos = 0;
+        m_ubx_len = 0;
+        m_ubx_ck_a = 0;
+        m_ubx_ck_b = 0;
+        m_ubx_rx_ck_a = 0;
+        m_raw_sync.reset();
+        m_raw_pps.reset();
+    }
+
+    void NmeaStreamParser::process(const BOARD_UART_FRAME* frames, std::size_t count)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            GpsStamp stamp;
+            stamp.sync_counter = frames[i].SyncCounter;
+            stamp.last_pps = frames[i].LastPPS;
+            consume(frames[i].Data, stamp);
+        }
+        m_stats.bytes += count;
+    }
+
+    void NmeaStreamParser::process(const BOARD_UART_RAW_FRAME* frames, std::size_t count)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const uint32_t data_lastpps = frames[i].data_lastpps;
+            GpsStamp stamp;
+            stamp.sync_counter = m_raw_sync.extend(frames[i].SyncCounter);
+            stamp.last_pps = m_raw_pps.extend(data_lastpps >> 8);
+            consume(static_cast<uint8_t>(data_lastpps & 0xFF), stamp);
+        }
+        m_stats.bytes += count;
+    }
+
+    void NmeaStreamParser::process(const uint8_t* data, std::size_t count, const GpsStamp& stamp, double counter_per_byte)
+    {
+        GpsStamp s = stamp;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            // the stamp is only used when a message starts
+            if (m_state == State::Idle && counter_per_byte > 0)
+            {
+                s.sync_counter = stamp.sync_counter
+                    + static_cast<uint64_t>(static_cast<double>(i) * counter_per_byte + 0.5);
+            }
+            consume(data[i], s);
+        }
+        m_stats.bytes += count;
+    }
+
+    const NmeaStreamParser::Statistics& NmeaStreamParser::getStatistics() const
+    {
+        return m_stats;
+    }
+
+    void NmeaStreamParser::consume(uint8_t byte, const GpsStamp& stamp)
+    {
+        switch (m_state)
+        {
+        case State::Idle:
+            if (byte == '$')
+            {
+                m_stamp = stamp;
+                m_nmea[0] = '$';
+                m_nmea_len = 1;
+                m_nmea_xor = 0;
+                m_nmea_has_checksum = false;
+                m_state = State::NmeaBody;
+            }
+            else if (byte == UBX_SYNC_1)
+            {
+                m_stamp = stamp;
+                m_state = State::UbxSync2;
+            }
+            break;
+
+        case State::NmeaBody:
+            if (byte == '*')
+            {
+                m_nmea_has_checksum = true;
+                m_state = State::NmeaChecksum1;
+            }
+            else if (byte == '\r' || byte == '\n')
+            {
+                finishNmea();
+            }
+            else if (byte == '$')
+            {
+                // truncated sentence, resynchronize on the new start
+                error(GpsParseError::NmeaFormat);
+                m_state = State::Idle;
+                consume(byte, stamp);
+            }
+            else if (m_nmea_len == MAX_NMEA_LENGTH)
+            {
+                error(GpsParseError::NmeaOverflow);
+                m_state = State::Idle;
+            }
+            else
+            {
+                m_nmea[m_nmea_len++] = static_cast<char>(byte);
+                m_nmea_xor ^= byte;
+            }
+            break;
+
+        case State::NmeaChecksum1:
+        {
+            const uint8_t v = HEX_TABLE.value[byte];
+            if (v == HEX_INVALID)
+            {
+                error(GpsParseError::NmeaFormat);
+                m_state = State::Idle;
+            }
+            else
+            {
+                m_nmea_checksum = static_cast<uint8_t>(v << 4);
+                m_state = State::NmeaChecksum2;
+            }
+            break;
+        }
+
+        case State::NmeaChecksum2:
+        {
+            const uint8_t v = HEX_TABLE.value[byte];
+            if (v == HEX_INVALID)
+            {
+                error(GpsParseError::NmeaFormat);
+                m_state = State::Idle;
+            }
+            else
+            {
+                m_nmea_checksum |= v;
+                finishNmea();
+            }
+            break;
+        }
+
+        case State::UbxSync2:
+            if (byte == UBX_SYNC_2)
+            {
+                m_ubx_pos = 0;
+                m_ubx_ck_a = 0;
+                m_ubx_ck_b = 0;
+                m_state = State::UbxHeader;
+            }
+            else
+            {
+                m_state = State::Idle;
+                consume(byte, stamp);
+            }
+            break;
+
+        case State::UbxHeader:
+            m_ubx_header[m_ubx_pos++] = byte;
+            m_ubx_ck_a = static_cast<uint8_t>(m_ubx_ck_a + byte);
+            m_ubx_ck_b = static_cast<uint8_t>(m_ubx_ck_b + m_ubx_ck_a);
+            if (m_ubx_pos == sizeof(m_ubx_header))
+            {
+                m_ubx_len = static_cast<std::size_t>(m_ubx_header[2]) | (static_cast<std::size_t>(m_ubx_header[3]) << 8);
+                m_ubx_pos = 0;
+                if (m_ubx_len > MAX_UBX_PAYLOAD)
+                {
+                    error(GpsParseError::UbxOverflow);
+                    m_state = State::Idle;
+                }
+                else
+                {
+                    m_state = (m_ubx_len == 0) ? State::UbxChecksum : State::UbxPayload;
+                }
+            }
+            break;
+
+        case State::UbxPayload:
+            m_ubx[m_ubx_pos++] = byte;
+            m_ubx_ck_a = static_cast<uint8_t>(m_ubx_ck_a + byte);
+            m_ubx_ck_b = static_cast<uint8_t>(m_ubx_ck_b + m_ubx_ck_a);
+            if (m_ubx_pos == m_ubx_len)
+            {
+                m_ubx_pos = 0;
+                m_state = State::UbxChecksum;
+            }
+            break;
+
+        case State::UbxChecksum:
+            if (m_ubx_pos == 0)
+            {
+                // keep received CK_A until CK_B arrives
+                m_ubx_rx_ck_a = byte;
+                m_ubx_pos = 1;
+            }
+            else
+            {
+                if (m_ubx_rx_ck_a == m_ubx_ck_a && byte == m_ubx_ck_b)
+                {
+                    finishUbx();
+                }
+                else
+                {
+                    error(GpsParseError::UbxChecksum);
+                }
+                m_state = State::Idle;
+            }
+            break;
+        }
+    }
+
+    void NmeaStreamParser::finishNmea()
+    {
+        m_state = State::Idle;
+        if (m_nmea_has_checksum && m_nmea_checksum != m_nmea_xor)
+        {
+            error(GpsParseError::NmeaChecksum);
+            return;
+        }
+        ++m_stats.nmea_sentences;
+        m_listener.onSentence(m_stamp, m_nmea, m_nmea_len);
+        dispatchNmea(m_nmea, m_nmea_len);
+    }
+
+    void NmeaStreamParser::finishUbx()
+    {
+        ++m_stats.ubx_messages;
+        UbxMessage msg;
+        msg.stamp = m_stamp;
+        msg.msg_class = m_ubx_header[0];
+        msg.msg_id = m_ubx_header[1];
+        msg.length = static_cast<uint16_t>(m_ubx_len);
+        msg.payload = m_ubx;
+        m_listener.onUbx(msg);
+    }
+
+    void NmeaStreamParser::dispatchNmea(const char* sentence, std::size_t length)
+    {
+        // "$TTSSS" with a two character talker id
+        if (length < 6)
+        {
+            return;
+        }
+        const char* type = sentence + 3;
+
+        FieldReader reader(sentence, length);
+        Field f;
+        reader.next(f);     // address field
+
+        if (std::memcmp(type, "GGA", 3) == 0)
+        {
+            NmeaGga gga;
+            gga.stamp = m_stamp;
+            copyTalker(gga.talker, sentence);
+            gga.time = parseTime(reader.next());
+            Field lat = reader.next();
+            Field ns = reader.next();
+            gga.latitude = parseCoordinate(lat, ns);
+            Field lon = reader.next();
+            Field ew = reader.next();
+            gga.longitude = parseCoordinate(lon, ew);
+            gga.quality = parseInt<uint8_t>(reader.next(), 0);
+            gga.satellites = parseInt<uint8_t>(reader.next(), 0);
+            gga.hdop = parseDouble(reader.next());
+            gga.altitude = parseDouble(reader.next());
+            reader.next();  // altitude unit
+            gga.geoid_separation = parseDouble(reader.next());
+            m_listener.onGga(gga);
+        }
+        else if (std::memcmp(type, "RMC", 3) == 0)
+        {
+            NmeaRmc rmc;
+            rmc.stamp = m_stamp;
+            copyTalker(rmc.talker, sentence);
+            rmc.time = parseTime(reader.next());
+            rmc.active = reader.next().first() == 'A';
+            Field lat = reader.next();
+            Field ns = reader.next();
+            rmc.latitude = parseCoordinate(lat, ns);
+            Field lon = reader.next();
+            Field ew = reader.next();
+            rmc.longitude = parseCoordinate(lon, ew);
+            rmc.speed_knots = parseDouble(reader.next());
+            rmc.course = parseDouble(reader.next());
+
+            Field date = reader.next();
+            uint32_t dd, mm, yy;
+            if (date.end - date.begin == 6
+                && parseUint(date.begin, date.begin + 2, dd)
+                && parseUint(date.begin + 2, date.begin + 4, mm)
+                && parseUint(date.begin + 4, date.begin + 6, yy))
+            {
+                rmc.day = static_cast<uint8_t>(dd);
+                rmc.month = static_cast<uint8_t>(mm);
+                // two digit year, pivot at the GPS epoch 1980
+                rmc.year = static_cast<uint16_t>((yy < 80 ? 2000 : 1900) + yy);
+            }
+            else
+            {
+                rmc.day = rmc.month = 0;
+                rmc.year = 0;
+            }
+
+            rmc.magnetic_variation = parseDouble(reader.next());
+            if (reader.next().first() == 'W')
+            {
+                rmc.magnetic_variation = -rmc.magnetic_variation;
+            }
+            rmc.mode = reader.next().first();
+            m_listener.onRmc(rmc);
+        }
+        else if (std::memcmp(type, "GSA", 3) == 0)
+        {
+            NmeaGsa gsa;
+            gsa.stamp = m_stamp;
+            copyTalker(gsa.talker, sentence);
+            gsa.selection_mode = reader.next().first();
+            gsa.fix_type = parseInt<uint8_t>(reader.next(), 0);
+            gsa.prn_count = 0;
+            for (int i = 0; i < NmeaGsa::MAX_PRN; ++i)
+            {
+                uint32_t prn;
+                Field p = reader.next();
+                if (parseUint(p.begin, p.end, prn))
+                {
+                    gsa.prn[gsa.prn_count++] = static_cast<uint16_t>(prn);
+                }
+            }
+            gsa.pdop = parseDouble(reader.next());
+            gsa.hdop = parseDouble(reader.next());
+            gsa.vdop = parseDouble(reader.next());
+            m_listener.onGsa(gsa);
+        }
+        else if (std::memcmp(type, "GSV", 3) == 0)
+        {
+            NmeaGsv gsv;
+            gsv.stamp = m_stamp;
+            copyTalker(gsv.talker, sentence);
+            gsv.total_messages = parseInt<uint8_t>(reader.next(), 0);
+            gsv.message_number = parseInt<uint8_t>(reader.next(), 0);
+            gsv.satellites_in_view = parseInt<uint8_t>(reader.next(), 0);
+            gsv.satellite_count = 0;
+            if (gsv.total_messages == 0 || gsv.message_number == 0)
+            {
+                error(GpsParseError::NmeaFormat);
+                return;
+            }
+            for (int i = 0; i < NmeaGsv::MAX_SATELLITES; ++i)
+            {
+                Field prn = reader.next();
+                Field elevation = reader.next();
+                Field azimuth = reader.next();
+                Field snr = reader.next();
+                uint32_t prn_value;
+                if (!parseUint(prn.begin, prn.end, prn_value))
+                {
+                    break;
+                }
+                NmeaGsv::Satellite& sat = gsv.satellites[gsv.satellite_count++];
+                sat.prn = static_cast<uint16_t>(prn_value);
+                sat.elevation = parseInt<int16_t>(elevation, -1);
+                sat.azimuth = parseInt<int16_t>(azimuth, -1);
+                sat.snr = parseInt<int16_t>(snr, -1);
+            }
+            m_listener.onGsv(gsv);
+        }
+    }
+
+    void NmeaStreamParser::error(GpsParseError err)
+    {
+        ++m_stats.errors;
+        m_listener.onError(err, m_stamp);
+    }
+
+} // trion
@@ -0,0 +1,167 @@
+// Copyright (c) DEWETRON GmbH 2026
+
+#include "trion_uart_raw_reader.h"
+#include "dewepxi_apicore.h"
+#include <algorithm>
+
+namespace
+{
+    const uint32_t PPS_MASK = 0x00FFFFFF;
+
+    struct RunOffsetLess
+    {
+        bool operator()(std::size_t offset, const trion::UartRunStamp& run) const
+        {
+            return offset < run.offset;
+        }
+    };
+
+} // namespace
+
+
+namespace trion
+{
+    UartRawReader::UartRawReader(int board_no, std::size_t reserve_bytes)
+        : m_board_no(board_no)
+        , m_run_gap(0)
+        , m_pps_counter(PPS_MASK)
+    {
+        m_data.reserve(reserve_bytes);
+        m_runs.reserve(64);
+        resetCounterExtension();
+    }
+
+    int UartRawReader::getBoardNo() const
+    {
+        return m_board_no;
+    }
+
+    void UartRawReader::setRunGap(uint64_t max_gap)
+    {
+        m_run_gap = max_gap;
+    }
+
+    uint64_t UartRawReader::getRunGap() const
+    {
+        return m_run_gap;
+    }
+
+    int UartRawReader::read(int* frame_count)
+    {
+        PBOARD_UART_RAW_FRAME frames = nullptr;
+        int count = 0;
+
+        int err = DeWeReadDmaUartRawFrame(m_board_no, &frames, &count);
+        if (frame_count)
+        {
+            *frame_count = 0;
+        }
+        if (err != ERR_NONE || count <= 0)
+        {
+            return err;
+        }
+
+        append(frames, static_cast<std::size_t>(count));
+        if (frame_count)
+        {
+            *frame_count = count;
+        }
+        return DeWeFreeDmaUartRawFrame(m_board_no, count);
+    }
+
+    void UartRawReader::append(const BOARD_UART_RAW_FRAME* frames, std::size_t count)
+    {
+        std::size_t pos = m_data.size();
+        m_data.resize(pos + count);
+        uint8_t* dst = m_data.data() + pos;
+
+        // local copies keep the loop state in registers
+        CounterExtender sync_counter = m_sync_counter;
+        uint64_t prev_sync = m_prev_sync;
+        uint32_t prev_pps = m_prev_pps;
+        bool have_prev = m_have_prev && !m_runs.empty();
+        const uint64_t run_gap = m_run_gap;
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const uint32_t data_lastpps = frames[i].data_lastpps;
+            const uint32_t sync = frames[i].SyncCounter;
+            const uint32_t pps = data_lastpps >> 8;
+
+            dst[i] = static_cast<uint8_t>(data_lastpps & 0xFF);
+
+            const uint64_t sync64 = sync_counter.extend(sync);
+
+            if (!have_prev
+                || pps != prev_pps
+                || (run_gap != 0 && sync64 - prev_sync > run_gap))
+            {
+                UartRunStamp run;
+                run.offset = pos + i;
+                run.sync_counter = sync64;
+                run.last_pps = m_pps_counter.extend(pps);
+                m_runs.push_back(run);
+                have_prev = true;
+            }
+            prev_sync = sync64;
+            prev_pps = pps;
+        }
+
+        m_sync_counter = sync_counter;
+        m_prev_sync = prev_sync;
+        m_prev_pps = prev_pps;
+        m_have_prev = have_prev;
+    }
+
+    void UartRawReader::clear()
+    {
+        m_data.clear();
+        m_runs.clear();
+    }
+
+    void UartRawReader::resetCounterExtension()
+    {
+        m_sync_counter.reset();
+        m_pps_counter.reset();
+        m_prev_sync = 0;
+        m_prev_pps = 0;
+        m_have_prev = false;
+    }
+
+    const uint8_t* UartRawReader::data() const
+    {
+        return m_data.data();
+    }
+
+    std::size_t UartRawReader::size() const
+    {
+        return m_data.size();
+    }
+
+    const UartRunStamp* UartRawReader::runs() const
+    {
+        return m_runs.data();
+    }
+
+    std::size_t UartRawReader::runCount() const
+    {
+        return m_runs.size();
+    }
+
+    std::size_t UartRawReader::runLength(std::size_t run) const
+    {
+        std::size_t end = (run + 1 < m_runs.size()) ? m_runs[run + 1].offset : m_data.size();
+        return end - m_runs[run].offset;
+    }
+
+    std::size_t UartRawReader::findRun(std::size_t offset) const
+    {
+        if (offset >= m_data.size() || m_runs.empty())
+        {
+            return m_runs.size();
+        }
+        auto it = std::upper_bound(m_runs.begin(), m_runs.end(), offset, RunOffsetLess());
+        return static_cast<std::size_t>(it - m_runs.begin()) - 1;
+    }
+
+} // trion
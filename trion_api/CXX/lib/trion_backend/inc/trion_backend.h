@@ -0,0 +1,168 @@
+// Copyright (c) DEWETRON GmbH 2026
+#pragma once
+
+#include "dewepxi_apicore.h"
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace trion
+{
+    enum class BackendType
+    {
+        TRION,      //!< local PXI boards (dwpxi_api)
+        TRIONET,    //!< TRIONET devices (dwpxi_netapi)
+    };
+
+    /**
+     * One loaded API library with its own function table.
+     *
+     * Unlike DeWePxiLoad, which binds the process wide function pointers,
+     * any number of backends can be loaded at the same time. Board numbers
+     * are local to the backend.
+     *
+     * @code
+     * auto net = trion::Backend::load(trion::BackendType::TRIONET);
+     * net->setParamStruct("trionetapi/config", "Network/IPV4/LocalIP", "192.168.0.10");
+     * net->init();
+     * if (net->hasCapability(DEWEPXI_CAP_READCANNG)) ...
+     * @endcode
+     */
+    class Backend
+    {
+    public:
+        /**
+         * File name of the library, same as in dewepxi_load.h and dewepxinet_load.h
+         */
+        static const char* getLibraryName(BackendType type);
+
+        /**
+         * @return nullptr if the library could not be loaded
+         */
+        static std::unique_ptr<Backend> load(BackendType type);
+        static std::unique_ptr<Backend> load(const std::string& library);
+
+        /**
+         * Calls DeWeDriverDeInit and unloads the library.
+         */
+        ~Backend();
+
+        Backend(const Backend&) = delete;
+        Backend& operator=(const Backend&) = delete;
+
+        /**
+         * DeWeDriverInit. TRIONET network settings have to be set before.
+         */
+        int init();
+        bool isInitialized() const;
+
+        /**
+         * Number of boards, also for DEMO mode
+         */
+        int getBoardCount() const;
+
+        const std::string& getLibrary() const;
+        int getRevision() const;
+        unsigned int getCapabilities() const;
+        bool hasCapability(unsigned int capability) const;
+
+        /**
+         * Function table for direct calls in acquisition loops.
+         */
+        const DEWEPXI_FUNCTION_TABLE& api() const
+        {
+            return m_table;
+        }
+
+        int getParam_i32(int board_no, unsigned int command, sint32& value) const;
+        int setParam_i32(int board_no, unsigned int command, sint32 value) const;
+        int getParam_i64(int board_no, unsigned int command, sint64& value) const;
+        int setParam_i64(int board_no, unsigned int command, sint64 value) const;
+
+        /**
+         * DeWeGetParamStruct_str and DeWeSetParamStruct_str of this backend, see dewepxi_apicxx.h
+         * The value is used as read buffer, there is no state shared between calls.
+         */
+        int getParamStruct(const std::string& target, const std::string& item, std::string& value) const;
+        int setParamStruct(const std::string& target, const std::string& item, const std::string& value) const;
+
+    private:
+        explicit Backend(const std::string& library);
+
+    private:
+        DEWEPXI_FUNCTION_TABLE m_table;
+        std::string m_library;
+        int m_board_count;
+        bool m_initialized;
+    };
+
+
+    /**
+     * Several backends with one board numbering, so one acquisition engine
+     * can use local and TRIONET boards at the same time.
+     *
+     * Boards are numbered in the order the backends are added: with two
+     * local boards added first and three TRIONET boards, 0..1 are the local
+     * and 2..4 the TRIONET boards. Board targets like "BoardID3/AI0", with the
+     * prefix in any case, are translated to the board number of the owning backend. Targets without
+     * board, like "trionetapi/config", are used with getBackend().
+     */
+    class BackendSet
+    {
+    public:
+        BackendSet();
+
+        /**
+         * Calls init() if not done yet, the backend is dropped if that fails.
+         * The boards of the backend start at toBoardNo(backend, 0).
+         */
+        int add(std::unique_ptr<Backend> backend);
+
+        std::size_t size() const;
+        Backend& getBackend(std::size_t index) const;
+
+        int getBoardCount() const;
+
+        /**
+         * @return the backend of the board, nullptr for an unknown board number
+         */
+        Backend* resolve(int board_no, int& local_board_no) const;
+
+        /**
+         * @return the board number in the set, -1 if backend is not part of the set
+         */
+        int toBoardNo(const Backend& backend, int local_board_no) const;
+
+        int getParam_i32(int board_no, unsigned int command, sint32& value) const;
+        int setParam_i32(int board_no, unsigned int command, sint32 value) const;
+        int getParam_i64(int board_no, unsigned int command, sint64& value) const;
+        int setParam_i64(int board_no, unsigned int command, sint64 value) const;
+
+        /**
+         * Command for all boards of all backends, eg CMD_OPEN_BOARD_ALL.
+         * @return the first error
+         */
+        int setParamAll_i32(unsigned int command, sint32 value) const;
+
+        /**
+         * @return ERR_INVALID_BOARD_NO if target is not "BoardIDn[/...]" with a known board
+         */
+        int getParamStruct(const std::string& target, const std::string& item, std::string& value);
+        int setParamStruct(const std::string& target, const std::string& item, const std::string& value) const;
+
+    private:
+        struct BoardRef
+        {
+            Backend* backend;
+            int local_board_no;
+        };
+
+        Backend* translate(const std::string& target, std::string& local_target) const;
+
+    private:
+        std::vector<std::unique_ptr<Backend>> m_backends;
+        std::vector<BoardRef> m_boards;
+    };
+
+} // trion
@@ -0,0 +1,346 @@
+// Copyright (c) DEWETRON GmbH 2026
+
+#include "trion_backend.h"
+
+// function table loader only, the application may use DeWePxiLoad itself
+#define DEWEPXI_LOAD_TABLE_ONLY
+#include "dewepxi_loadcore.h"
+
+#include <cctype>
+#include <charconv>
+#include <cstdlib>
+#include <cstring>
+
+namespace
+{
+    const size_t DEFAULT_BUFFER_SIZE = 1024;
+    const char BOARD_PREFIX[] = "BoardID";
+
+#ifdef BUILD_X64
+#  ifdef WIN32
+    const char TRION_LIBRARY[] = "dwpxi_api_x64.dll";
+    const char TRIONET_LIBRARY[] = "dwpxi_netapi_x64.dll";
+#  elif defined(__APPLE__)
+    const char TRION_LIBRARY[] = "libdwpxi_api_x64.dylib";
+    const char TRIONET_LIBRARY[] = "libdwpxi_netapi_x64.dylib";
+#  else
+    const char TRION_LIBRARY[] = "libdwpxi_api_x64.so";
+    const char TRIONET_LIBRARY[] = "libdwpxi_netapi_x64.so";
+#  endif
+#else
+#  ifdef WIN32
+    const char TRION_LIBRARY[] = "dwpxi_api.dll";
+    const char TRIONET_LIBRARY[] = "dwpxi_netapi.dll";
+#  elif defined(__APPLE__)
+    const char TRION_LIBRARY[] = "libdwpxi_api.dylib";
+    const char TRIONET_LIBRARY[] = "libdwpxi_netapi.dylib";
+#  else
+    const char TRION_LIBRARY[] = "libdwpxi_api.so";
+    const char TRIONET_LIBRARY[] = "libdwpxi_netapi.so";
+#  endif
+#endif
+
+    bool startsWithNoCase(const std::string& text, const char* prefix, size_t prefix_size)
+    {
+        if (text.size() < prefix_size)
+        {
+            return false;
+        }
+        for (size_t n = 0; n < prefix_size; ++n)
+        {
+            if (std::tolower(static_cast<unsigned char>(text[n])) != std::tolower(static_cast<unsigned char>(prefix[n])))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+} // namespace
+
+
+namespace trion
+{
+    const char* Backend::getLibraryName(BackendType type)
+    {
+        return type == BackendType::TRIONET ? TRIONET_LIBRARY : TRION_LIBRARY;
+    }
+
+    std::unique_ptr<Backend> Backend::load(BackendType type)
+    {
+        return load(getLibraryName(type));
+    }
+
+    std::unique_ptr<Backend> Backend::load(const std::string& library)
+    {
+        std::unique_ptr<Backend> backend(new Backend(library));
+        if (DeWePxiLoadTable(library.c_str(), &backend->m_table) <= 0)
+        {
+            return nullptr;
+        }
+        return backend;
+    }
+
+    Backend::Backend(const std::string& library)
+        : m_table()
+        , m_library(library)
+        , m_board_count(0)
+        , m_initialized(false)
+    {
+    }
+
+    Backend::~Backend()
+    {
+        DeWePxiUnloadTable(&m_table);
+    }
+
+    int Backend::init()
+    {
+        int boards = 0;
+        int err = m_table.DeWeDriverInit(&boards);
+        if (err > 0)
+        {
+            return err;
+        }
+        // negative in DEMO mode
+        m_board_count = std::abs(boards);
+        m_initialized = true;
+        return err;
+    }
+
+    bool Backend::isInitialized() const
+    {
+        return m_initialized;
+    }
+
+    int Backend::getBoardCount() const
+    {
+        return m_board_count;
+    }
+
+    const std::string& Backend::getLibrary() const
+    {
+        return m_library;
+    }
+
+    int Backend::getRevision() const
+    {
+        return m_table.revision;
+    }
+
+    unsigned int Backend::getCapabilities() const
+    {
+        return m_table.capabilities;
+    }
+
+    bool Backend::hasCapability(unsigned int capability) const
+    {
+        return (m_table.capabilities & capability) == capability;
+    }
+
+    int Backend::getParam_i32(int board_no, unsigned int command, sint32& value) const
+    {
+        return m_table.DeWeGetParam_i32(board_no, command, &value);
+    }
+
+    int Backend::setParam_i32(int board_no, unsigned int command, sint32 value) const
+    {
+        return m_table.DeWeSetParam_i32(board_no, command, value);
+    }
+
+    int Backend::getParam_i64(int board_no, unsigned int command, sint64& value) const
+    {
+        return m_table.DeWeGetParam_i64(board_no, command, &value);
+    }
+
+    int Backend::setParam_i64(int board_no, unsigned int command, sint64 value) const
+    {
+        return m_table.DeWeSetParam_i64(board_no, command, value);
+    }
+
+    int Backend::getParamStruct(const std::string& target, const std::string& item, std::string& value) const
+    {
+        // the value is the buffer, so concurrent calls do not share state
+        value.resize(DEFAULT_BUFFER_SIZE);
+
+        int err = m_table.DeWeGetParamStruct_str(target.c_str(), item.c_str(), &value[0], static_cast<uint32>(value.size()));
+        if (err == ERROR_BUFFER_TOO_SMALL)
+        {
+            uint32 needed = 0;
+            err = m_table.DeWeGetParamStruct_strLEN(target.c_str(), item.c_str(), &needed);
+            if (err == ERR_NONE)
+            {
+                // room for the terminator, whether included by the API or not
+                value.resize(static_cast<size_t>(needed) + 1);
+                err = m_table.DeWeGetParamStruct_str(target.c_str(), item.c_str(), &value[0], static_cast<uint32>(value.size()));
+            }
+        }
+
+        if (err == ERR_NONE)
+        {
+            value.back() = 0;
+            value.resize(strlen(value.c_str()));
+        }
+        else
+        {
+            value.clear();
+        }
+        return err;
+    }
+
+    int Backend::setParamStruct(const std::string& target, const std::string& item, const std::string& value) const
+    {
+        return m_table.DeWeSetParamStruct_str(target.c_str(), item.c_str(), value.c_str());
+    }
+
+
+    BackendSet::BackendSet()
+    {
+    }
+
+    int BackendSet::add(std::unique_ptr<Backend> backend)
+    {
+        if (!backend)
+        {
+            return ERR_INVALID_VALUE;
+        }
+        if (!backend->isInitialized())
+        {
+            int err = backend->init();
+            if (err > 0)
+            {
+                return err;
+            }
+        }
+
+        for (int board = 0; board < backend->getBoardCount(); ++board)
+        {
+            m_boards.push_back(BoardRef{ backend.get(), board });
+        }
+        m_backends.push_back(std::move(backend));
+        return ERR_NONE;
+    }
+
+    std::size_t BackendSet::size() const
+    {
+        return m_backends.size();
+    }
+
+    Backend& BackendSet::getBackend(std::size_t index) const
+    {
+        return *m_backends.at(index);
+    }
+
+    int BackendSet::getBoardCount() const
+    {
+        return static_cast<int>(m_boards.size());
+    }
+
+    Backend* BackendSet::resolve(int board_no, int& local_board_no) const
+    {
+        if (board_no < 0 || board_no >= static_cast<int>(m_boards.size()))
+        {
+            return nullptr;
+        }
+        const BoardRef& ref = m_boards[board_no];
+        local_board_no = ref.local_board_no;
+        return ref.backend;
+    }
+
+    int BackendSet::toBoardNo(const Backend& backend, int local_board_no) const
+    {
+        int first = 0;
+        for (const auto& entry : m_backends)
+        {
+            if (entry.get() == &backend)
+            {
+                return (local_board_no >= 0 && local_board_no < backend.getBoardCount()) ? first + local_board_no : -1;
+            }
+            first += entry->getBoardCount();
+        }
+        return -1;
+    }
+
+    int BackendSet::getParam_i32(int board_no, unsigned int command, sint32& value) const
+    {
+        int local = 0;
+        Backend* backend = resolve(board_no, local);
+        return backend ? backend->getParam_i32(local, command, value) : ERR_INVALID_BOARD_NO;
+    }
+
+    int BackendSet::setParam_i32(int board_no, unsigned int command, sint32 value) const
+    {
+        int local = 0;
+        Backend* backend = resolve(board_no, local);
+        return backend ? backend->setParam_i32(local, command, value) : ERR_INVALID_BOARD_NO;
+    }
+
+    int BackendSet::getParam_i64(int board_no, unsigned int command, sint64& value) const
+    {
+        int local = 0;
+        Backend* backend = resolve(board_no, local);
+        return backend ? backend->getParam_i64(local, command, value) : ERR_INVALID_BOARD_NO;
+    }
+
+    int BackendSet::setParam_i64(int board_no, unsigned int command, sint64 value) const
+    {
+        int local = 0;
+        Backend* backend = resolve(board_no, local);
+        return backend ? backend->setParam_i64(local, command, value) : ERR_INVALID_BOARD_NO;
+    }
+
+    int BackendSet::setParamAll_i32(unsigned int command, sint32 value) const
+    {
+        int result = ERR_NONE;
+        for (const auto& backend : m_backends)
+        {
+            int err = backend->setParam_i32(0, command, value);
+            if (err > 0 && result == ERR_NONE)
+            {
+                result = err;
+            }
+        }
+        return result;
+    }
+
+    int BackendSet::getParamStruct(const std::string& target, const std::string& item, std::string& value)
+    {
+        std::string local_target;
+        Backend* backend = translate(target, local_target);
+        return backend ? backend->getParamStruct(local_target, item, value) : ERR_INVALID_BOARD_NO;
+    }
+
+    int BackendSet::setParamStruct(const std::string& target, const std::string& item, const std::string& value) const
+    {
+        std::string local_target;
+        Backend* backend = translate(target, local_target);
+        return backend ? backend->setParamStruct(local_target, item, value) : ERR_INVALID_BOARD_NO;
+    }
+
+    Backend* BackendSet::translate(const std::string& target, std::string& local_target) const
+    {
+        const size_t prefix_size = sizeof(BOARD_PREFIX) - 1;
+        if (!startsWithNoCase(target, BOARD_PREFIX, prefix_size))
+        {
+            return nullptr;
+        }
+
+        const char* begin = target.data() + prefix_size;
+        const char* end = target.data() + target.size();
+        int board_no = 0;
+        auto result = std::from_chars(begin, end, board_no);
+        if (result.ec != std::errc() || result.ptr == begin || (result.ptr != end && *result.ptr != '/'))
+        {
+            return nullptr;
+        }
+
+        int local = 0;
+        Backend* backend = resolve(board_no, local);
+        if (backend)
+        {
+            local_target = BOARD_PREFIX + std::to_string(local) + std::string(result.ptr, end);
+        }
+        return backend;
+    }
+
+} // trion
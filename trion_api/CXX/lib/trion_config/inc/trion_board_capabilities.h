@@ -0,0 +1,181 @@
+// Copyright (c) DEWETRON GmbH 2026
+#pragma once
+
+#include <pugixml.hpp>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace trion
+{
+    /**
+     * Board capabilities, parsed once from the BoardProperties XML document.
+     *
+     * The document is flattened into arrays of channels, modes and properties.
+     * All names and enumerated values are interned, properties are found by
+     * one hash lookup of (channel, mode, property).
+     *
+     * Channels are addressed as in the properties document ("AI0", "CNT1",
+     * "BoardCNT0", ...). Acquisition properties are addressed by their group
+     * path ("AcqProp", "AcqProp/SyncSettings/SyncIn") without mode.
+     * Channel level properties like "Used" are addressed with an empty mode.
+     * Names are not case sensitive, as in the API.
+     *
+     * Usage:
+     * @code
+     * trion::BoardCapabilities caps;
+     * std::string xml;
+     * DeWeGetParamStruct_str_s("BoardID0", "BoardProperties", xml);
+     * caps.load(xml);
+     * double min_sr, max_sr;
+     * caps.getLimits("AcqProp", "", "SampleRate", min_sr, max_sr);
+     * for (std::size_t i = 0; i < caps.getModeCount("AI0"); ++i)
+     * {
+     *     const std::string& mode = caps.getModeName("AI0", i);
+     *     double rmin, rmax;
+     *     caps.getRangeLimits("AI0", mode, rmin, rmax);
+     * }
+     * @endcode
+     */
+    class BoardCapabilities
+    {
+    public:
+        BoardCapabilities();
+
+        /**
+         * Parse the document returned by DeWeGetParamStruct_str("BoardIDn", "BoardProperties").
+         * @return false if the document could not be parsed
+         */
+        bool load(const std::string& properties_xml);
+        bool isLoaded() const;
+        void clear();
+
+        bool hasChannel(const std::string& channel) const;
+
+        /**
+         * Number of channels of one type, eg "AI".
+         */
+        std::size_t getChannelCount(const std::string& prefix) const;
+
+        /**
+         * Channel names of one type in document order, eg "AI0", "AI1", ...
+         */
+        std::vector<std::string> getChannels(const std::string& prefix) const;
+
+        std::size_t getModeCount(const std::string& channel) const;
+
+        /**
+         * @return the mode name, or an empty string if out of range
+         */
+        const std::string& getModeName(const std::string& channel, std::size_t index) const;
+        bool hasMode(const std::string& channel, const std::string& mode) const;
+
+        bool hasProperty(const std::string& channel, const std::string& mode, const std::string& item) const;
+        bool isProgrammable(const std::string& channel, const std::string& mode, const std::string& item) const;
+        bool isReadOnly(const std::string& channel, const std::string& mode, const std::string& item) const;
+
+        /**
+         * Enumerated values (IDn children) of a property.
+         */
+        std::size_t getValueCount(const std::string& channel, const std::string& mode, const std::string& item) const;
+        const std::string& getValue(const std::string& channel, const std::string& mode, const std::string& item,
+            std::size_t index) const;
+        std::vector<std::string> getValues(const std::string& channel, const std::string& mode, const std::string& item) const;
+
+        /**
+         * Numeric enumerated values, eg the supported ResolutionAI.
+         * Non numeric values are skipped.
+         */
+        std::vector<double> getNumericValues(const std::string& channel, const std::string& mode, const std::string& item) const;
+
+        /**
+         * Numeric limits of a property: ProgMin/ProgMax if given,
+         * otherwise the smallest and largest numeric enumerated value.
+         * @return false if the property has no numeric limits
+         */
+        bool getLimits(const std::string& channel, const std::string& mode, const std::string& item,
+            double& min_value, double& max_value) const;
+
+        /**
+         * Smallest lower and largest upper limit of all "Range" values of a channel mode.
+         * Range values with a single number ("10 V") are taken as symmetrical
+         * (-10..10), as are ProgMin/ProgMax of a programmable range, of which
+         * only ProgMax is used. Asymmetric ranges have to be listed as "-5..10 V".
+         * @return false if the mode has no parsable ranges
+         */
+        bool getRangeLimits(const std::string& channel, const std::string& mode,
+            double& min_value, double& max_value) const;
+
+        /**
+         * Check a value against the enumerated values and the programmable limits.
+         * Values of programmable properties that are not plain numbers, eg
+         * with a unit, are not checked against the limits.
+         */
+        bool isValidValue(const std::string& channel, const std::string& mode, const std::string& item,
+            const std::string& value) const;
+
+        /**
+         * Parse a range like "10 V" (symmetrical, -10..10) or "-5..10 V" / "0..20 mA".
+         * @return false if the text does not start with a number
+         */
+        static bool parseRange(const char* text, double& min_value, double& max_value);
+
+    private:
+        enum PropertyFlags : uint8_t
+        {
+            PROGRAMMABLE = 0x01,
+            READ_ONLY    = 0x02,
+            HAS_LIMITS   = 0x04,
+        };
+
+        struct Property
+        {
+            uint32_t name;
+            uint32_t values_begin;
+            uint32_t values_end;
+            double prog_min;
+            double prog_max;
+            uint8_t flags;
+        };
+
+        struct Mode
+        {
+            uint32_t name;
+        };
+
+        struct Channel
+        {
+            uint32_t name;
+            uint32_t modes_begin;
+            uint32_t modes_end;
+        };
+
+        static const uint32_t NO_STRING = 0xFFFFFFFF;
+
+        uint32_t intern(const char* text);
+        uint32_t lookup(const std::string& text) const;
+        const Channel* findChannel(const std::string& channel) const;
+        const Property* findProperty(const std::string& channel, const std::string& mode, const std::string& item) const;
+        static uint64_t propertyKey(uint32_t channel, uint32_t mode, uint32_t name);
+
+        void addProperty(pugi::xml_node property, uint32_t channel, uint32_t mode);
+        void addAcquisitionGroup(pugi::xml_node group, const std::string& path);
+        void addChannel(pugi::xml_node channel);
+
+    private:
+        std::vector<std::string> m_strings;
+        std::unordered_map<std::string, uint32_t> m_string_ids;
+        std::unordered_map<std::string, uint32_t> m_lower_ids;     //!< lower case, first occurrence
+
+        std::vector<Channel> m_channels;
+        std::vector<Mode> m_modes;
+        std::vector<Property> m_properties;
+        std::vector<uint32_t> m_values;
+
+        std::unordered_map<uint32_t, uint32_t> m_channel_index;
+        std::unordered_map<uint64_t, uint32_t> m_property_index;
+        bool m_loaded;
+    };
+
+} // trion
@@ -0,0 +1,131 @@
+// Copyright (c) DEWETRON GmbH 2026
+#pragma once
+
+#include "trion_config_transaction.h"
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace trion
+{
+    /**
+     * A set of settings (target, item, value) in the order they have
+     * to be applied. Setting the same target and item again replaces
+     * the value but keeps the position. Targets and items are not case
+     * sensitive, as in the API.
+     */
+    class ConfigState
+    {
+    public:
+        void set(const std::string& target, const std::string& item, const std::string& value);
+
+        /**
+         * @return false if target/item is not part of the state
+         */
+        bool get(const std::string& target, const std::string& item, std::string& value) const;
+
+        /**
+         * Remove all settings of one board.
+         */
+        void eraseBoard(int board_no);
+
+        void clear();
+        std::size_t size() const;
+        const std::vector<ConfigEntry>& getEntries() const;
+
+        /**
+         * Settings of this state that differ from (or are missing in) the applied state.
+         *
+         * If a channel group setting (eg "AIAll") changes, the settings of the
+         * same item for single channels of that group are included as well,
+         * because the group setting overwrites them. If a Mode changes, the
+         * other settings of the channel (or of all channels of a group) are
+         * included, because the mode change resets them. These settings are
+         * ordered behind the group or mode setting, wherever they were set.
+         */
+        std::vector<ConfigEntry> diff(const ConfigState& applied) const;
+
+    private:
+        typedef std::pair<std::string, std::string> Key;
+        std::vector<ConfigEntry> m_entries;
+        std::map<Key, std::size_t> m_index;
+    };
+
+    /**
+     * One CMD_UPDATE_PARAM_* call
+     */
+    struct UpdateCommand
+    {
+        int command;
+        int value;
+    };
+
+    /**
+     * Select the update commands needed to apply changed settings of one board.
+     *
+     * - AcqProp SampleRate: CMD_UPDATE_PARAM_ACQ_SR
+     * - AcqProp OperationMode/ExtTrigger/ExtClk, SyncSettings and Timing: CMD_UPDATE_PARAM_ACQ_TIMING
+     * - other AcqProp settings: CMD_UPDATE_PARAM_ACQ
+     * - AI channels: CMD_UPDATE_PARAM_AI for one channel, or UPDATE_ALL_CHANNELS
+     * - CNT, BoardCNT, DI, CAN, CANFD, UART and ARef channels: their CMD_UPDATE_PARAM_*
+     *
+     * More than one acquisition command is merged into CMD_UPDATE_PARAM_ACQ_ALL.
+     * Changes of "Used" alter the acquired channel list, they and any
+     * setting that cannot be classified fall back to CMD_UPDATE_PARAM_ALL.
+     *
+     * @param changes are the changed settings, targets without board prefix are ignored
+     */
+    std::vector<UpdateCommand> selectUpdateCommands(const std::vector<ConfigEntry>& changes);
+
+    /**
+     * Keeps the last applied configuration per board and applies only
+     * the difference to a new desired configuration.
+     *
+     * Usage:
+     * @code
+     * trion::ConfigStateTracker tracker;
+     * trion::ConfigState desired;
+     * desired.set("BoardID0/AcqProp", "SampleRate", "10000");
+     * desired.set("BoardID0/AI0", "Range", "10 V");
+     * tracker.apply(desired);     // first run: everything is set
+     * desired.set("BoardID0/AI0", "Range", "1 V");
+     * tracker.apply(desired);     // only AI0 Range, CMD_UPDATE_PARAM_AI for channel 0
+     * @endcode
+     */
+    class ConfigStateTracker
+    {
+    public:
+        /**
+         * Compute the changes and update commands without applying them.
+         * @param commands receives the update commands per board
+         */
+        void plan(const ConfigState& desired, std::vector<ConfigEntry>& changes,
+            std::map<int, std::vector<UpdateCommand>>& commands) const;
+
+        /**
+         * Apply the changed settings and the selected update commands.
+         * Successfully applied settings are recorded as applied state.
+         * @param issues receives failed settings and commands, may be null
+         * @return ERR_NONE or the first error
+         */
+        int apply(const ConfigState& desired, std::vector<ConfigIssue>* issues = nullptr);
+
+        /**
+         * Forget the applied state of a board (eg after CMD_RESET_BOARD
+         * or a configuration change outside of this tracker).
+         */
+        void invalidate(int board_no);
+
+        /**
+         * Forget all applied state.
+         */
+        void invalidate();
+
+        const ConfigState& getApplied() const;
+
+    private:
+        ConfigState m_applied;
+    };
+
+} // trion
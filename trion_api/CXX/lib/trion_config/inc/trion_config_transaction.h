@@ -0,0 +1,128 @@
+// Copyright (c) DEWETRON GmbH 2026
+#pragma once
+
+#include "trion_property_validator.h"
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace trion
+{
+    /**
+     * Split a target like "BoardID3/AI0" into board number and remaining path.
+     * @return false if the target does not address a board
+     */
+    bool parseBoardTarget(const std::string& target, int& board_no, std::string& path);
+
+    /**
+     * One setting as passed to DeWeSetParamStruct_str
+     */
+    struct ConfigEntry
+    {
+        std::string target;
+        std::string item;
+        std::string value;
+    };
+
+    /**
+     * Validation or apply problem of one entry
+     */
+    struct ConfigIssue
+    {
+        ConfigEntry entry;
+        int error;
+        std::string message;
+    };
+
+    /**
+     * Collects settings and applies them with a few API calls per board.
+     *
+     * Instead of one DeWeSetParamStruct_str call per property (one network
+     * round trip each over TRIONET), commit() does per board:
+     * - read the current board configuration document ("config")
+     * - merge all collected settings into the document
+     * - load the document with one DeWeSetParamStruct_str(board, "config", xml)
+     * - apply it with one CMD_UPDATE_PARAM_ALL
+     *
+     * Settings that cannot be located in the configuration document and
+     * targets that do not address a board (eg "trionetapi/config") are
+     * applied individually, in the order they were added.
+     *
+     * Before anything is applied, all settings are validated locally
+     * against the BoardProperties document of each board.
+     *
+     * Usage:
+     * @code
+     * trion::ConfigTransaction tr;
+     * tr.set("BoardID0/AcqProp", "SampleRate", "10000");
+     * tr.set("BoardID0/AIAll", "Used", "False");
+     * tr.set("BoardID0/AI0", "Used", "True");
+     * tr.set("BoardID0/AI0", "Range", "10 V");
+     * std::vector<trion::ConfigIssue> issues;
+     * int err = tr.commit(&issues);
+     * @endcode
+     */
+    class ConfigTransaction
+    {
+    public:
+        ConfigTransaction();
+        ~ConfigTransaction();
+
+        /**
+         * Add a setting. A later setting of the same target and item
+         * replaces the value of the earlier one.
+         */
+        void set(const std::string& target, const std::string& item, const std::string& value);
+
+        /**
+         * Provide the BoardProperties document of a board.
+         * Otherwise it is read from the API when needed.
+         */
+        void setBoardProperties(int board_no, const std::string& properties_xml);
+
+        /**
+         * Skip local validation (eg for settings not described in the properties).
+         */
+        void setValidation(bool enable);
+
+        /**
+         * Validate all settings.
+         * @param issues receives one entry per invalid setting
+         * @return ERR_NONE or the first error
+         */
+        int validate(std::vector<ConfigIssue>& issues);
+
+        /**
+         * Validate and apply all settings, then clear the transaction.
+         * Nothing is applied if the validation fails.
+         * If the board reports problems loading the configuration document,
+         * the per property results ("configresult") are added to issues,
+         * warnings with their negative codes.
+         * @param issues receives validation and apply problems, may be null
+         * @return ERR_NONE or the first error
+         */
+        int commit(std::vector<ConfigIssue>* issues = nullptr);
+
+        void clear();
+
+        std::size_t size() const;
+        const std::vector<ConfigEntry>& getEntries() const;
+
+        /**
+         * The boards addressed by the collected settings.
+         */
+        std::vector<int> getBoards() const;
+
+    private:
+        BoardPropertyValidator* getValidator(int board_no);
+        int applyBoard(int board_no, const std::vector<const ConfigEntry*>& entries, std::vector<ConfigIssue>& issues);
+        int applySingle(const ConfigEntry& entry, std::vector<ConfigIssue>& issues);
+
+    private:
+        std::vector<ConfigEntry> m_entries;
+        std::map<int, std::unique_ptr<BoardPropertyValidator>> m_validators;
+        bool m_validate;
+    };
+
+} // trion
@@ -0,0 +1,58 @@
+// Copyright (c) DEWETRON GmbH 2026
+#pragma once
+
+#include <pugixml.hpp>
+#include <set>
+#include <string>
+
+/**
+ * XML helpers shared by the trion_config classes.
+ * Element and attribute names are matched like the API matches targets
+ * and items: ignoring case.
+ */
+namespace trion
+{
+    /**
+     * Compare names like the API does, ignoring ASCII case.
+     */
+    bool equalsNoCase(const char* a, const char* b);
+    bool equalsNoCase(const std::string& a, const std::string& b);
+
+    /**
+     * First child element with the given name, ignoring case.
+     */
+    pugi::xml_node findChild(pugi::xml_node node, const char* name);
+
+    /**
+     * Attribute with the given name, ignoring case.
+     */
+    pugi::xml_attribute findAttribute(pugi::xml_node node, const char* name);
+
+    /**
+     * Walk a '/' separated path of element names, ignoring case.
+     * An empty path returns node itself.
+     */
+    pugi::xml_node walk(pugi::xml_node node, const std::string& path);
+
+    /**
+     * Enumerated values are stored as child elements ID0, ID1, ...
+     */
+    bool isIdNode(pugi::xml_node node);
+
+    std::string toLower(std::string text);
+
+    /**
+     * Names of values that change without a set, eg clocks, temperatures,
+     * sensor readings or TEDS: SystemTime, Temp*, Teds*, SensorOffset,
+     * AmplifierOffset, ModeCheck, SelfJustage, ThreeWireInternalLineResistance
+     * and Value. Lower case, a trailing '*' matches as prefix.
+     */
+    std::set<std::string> getVolatileNames();
+
+    /**
+     * A query is volatile if its command or an element of its target path
+     * matches one of the lower case names, ignoring case.
+     */
+    bool isVolatileQuery(const std::string& target, const std::string& command, const std::set<std::string>& names);
+
+} // trion
@@ -0,0 +1,159 @@
+// Copyright (c) DEWETRON GmbH 2026
+#pragma once
+
+#include "dewepxi_err.h"
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <set>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace trion
+{
+    /**
+     * Parse a complete number with std::from_chars, independent of the
+     * locale. Surrounding whitespace is allowed, a unit is not.
+     * The integer variant also accepts integral values in floating point
+     * notation like "1e4" or "10000.0".
+     */
+    bool parseNumber(std::string_view text, double& value);
+    bool parseNumber(std::string_view text, int64_t& value);
+
+    /**
+     * Shortest representation that parses back to exactly the same value.
+     */
+    std::string formatNumber(double value);
+    std::string formatNumber(int64_t value);
+
+    /**
+     * Typed access to numeric properties like "SampleRate", "scalevalue",
+     * "scaleoffset" or "Channels" without sscanf and printf.
+     *
+     * Parsed values are cached per (target, item). A set drops the cached
+     * values of the board, because other values may depend on it (eg
+     * "scalevalue" on "Range"). refresh() reads all values of the
+     * configuration document of a board (Acquisition/AcqProp and the
+     * channels) with one "config" query, which is the way to go for polling
+     * loops. Derived values like "scalevalue" are not part of it and are
+     * read by get() on a miss. Volatile values, like temperatures or
+     * "SystemTime", are never cached and read by every get(), see
+     * getVolatileNames():
+     *
+     * @code
+     * trion::NumericParams params;
+     * params.set("BoardID0/AcqProp", "SampleRate", 10000.0);
+     * while (polling)
+     * {
+     *     params.refresh(0);
+     *     double sample_rate, range, offset;
+     *     params.get("BoardID0/AcqProp", "SampleRate", sample_rate);
+     *     params.get("BoardID0/AI0", "Range", range);
+     *     params.get("BoardID0/AI0", "InputOffset", offset);
+     * }
+     * @endcode
+     */
+    class NumericParams
+    {
+    public:
+        NumericParams();
+
+        /**
+         * @return ERR_NONE, the API error, or ERR_INVALID_VALUE if the value
+         *         is not numeric or does not fit into T
+         */
+        template <typename T>
+        int get(const std::string& target, const std::string& item, T& value);
+
+        template <typename T>
+        int set(const std::string& target, const std::string& item, T value);
+
+        /**
+         * Read the configuration document of a board and cache all numeric values.
+         */
+        int refresh(int board_no);
+
+        /**
+         * Never cache items with this name or target path element.
+         * @param name is matched ignoring case, a trailing '*' matches as prefix
+         */
+        void addVolatile(const std::string& name);
+
+        void invalidate(int board_no);
+        void clear();
+        std::size_t size() const;
+
+    private:
+        enum EntryFlags : uint8_t
+        {
+            HAS_INTEGER = 0x01,
+        };
+
+        struct Entry
+        {
+            double number;
+            int64_t integer;
+            uint8_t flags;
+        };
+
+        typedef std::pair<std::string, std::string> Key;
+
+        int getEntry(const std::string& target, const std::string& item, const Entry*& entry);
+        int setText(const std::string& target, const std::string& item, const std::string& text);
+        void store(const std::string& target, const std::string& item, std::string_view text);
+        static bool parseEntry(std::string_view text, Entry& entry);
+
+    private:
+        std::map<Key, Entry> m_values;
+        std::set<std::string> m_volatile;   //!< lower case
+        Entry m_volatile_entry;             //!< last volatile value read
+        std::vector<char> m_buffer;
+    };
+
+
+    template <typename T>
+    int NumericParams::get(const std::string& target, const std::string& item, T& value)
+    {
+        static_assert(std::is_arithmetic<T>::value, "numeric type expected");
+        const Entry* entry = nullptr;
+        int err = getEntry(target, item, entry);
+        if (err != ERR_NONE)
+        {
+            return err;
+        }
+
+        if constexpr (std::is_integral<T>::value)
+        {
+            if (!(entry->flags & HAS_INTEGER)
+                || entry->integer < static_cast<int64_t>(std::numeric_limits<T>::min())
+                || (entry->integer > 0 && static_cast<uint64_t>(entry->integer) > static_cast<uint64_t>(std::numeric_limits<T>::max())))
+            {
+                return ERR_INVALID_VALUE;
+            }
+            value = static_cast<T>(entry->integer);
+        }
+        else
+        {
+            value = static_cast<T>(entry->number);
+        }
+        return ERR_NONE;
+    }
+
+    template <typename T>
+    int NumericParams::set(const std::string& target, const std::string& item, T value)
+    {
+        static_assert(std::is_arithmetic<T>::value, "numeric type expected");
+        if constexpr (std::is_integral<T>::value)
+        {
+            return setText(target, item, formatNumber(static_cast<int64_t>(value)));
+        }
+        else
+        {
+            return setText(target, item, formatNumber(static_cast<double>(value)));
+        }
+    }
+
+} // trion
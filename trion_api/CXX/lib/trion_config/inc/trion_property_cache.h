@@ -0,0 +1,116 @@
+// Copyright (c) DEWETRON GmbH 2026
+#pragma once
+
+#include <pugixml.hpp>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <utility>
+
+namespace trion
+{
+    /**
+     * Client side cache for property queries.
+     *
+     * Use the get/set methods instead of DeWeGetParamStruct_str,
+     * DeWeGetParamXML_str, DeWeSetParamStruct_str and DeWeSetParam_i32.
+     * Over TRIONET each of these calls is a network round trip.
+     *
+     * - DeWeGetParamStruct_str results are cached by (target, command).
+     * - Queries of "BoardIDn/BoardProperties..." via DeWeGetParamXML_str are
+     *   evaluated locally (XPath) on the BoardProperties document, which is
+     *   read once per board (see prefetch).
+     * - Capability data (BoardProperties, BoardName, Channels) is kept until
+     *   the board is opened, closed or reset.
+     * - All other cached values of a board are dropped on every set, and on
+     *   every DeWeSetParam_i32 command except starting and stopping the acquisition.
+     *   Setting a target that does not address a board drops all cached values.
+     * - Volatile values are never cached: they change without a set, like
+     *   "BoardIDn/AcqProp/Timing/SystemTime", board temperatures, TEDS reads
+     *   or sensor offsets. A query is volatile if its command or an element of
+     *   its target path matches a volatile name, ignoring case: SystemTime,
+     *   Temp*, Teds*, SensorOffset, AmplifierOffset, ModeCheck, SelfJustage,
+     *   ThreeWireInternalLineResistance and Value. More names are added with
+     *   addVolatile.
+     *
+     * All methods are thread safe. The lock is not held during API calls, so
+     * a slow call over TRIONET does not block other threads. A value read
+     * while a set is in progress is returned but not cached.
+     */
+    class PropertyCache
+    {
+    public:
+        struct Statistics
+        {
+            uint64_t hits;          //!< answered from cache
+            uint64_t local_queries; //!< XPath queries evaluated on a prefetched document
+            uint64_t misses;        //!< forwarded to the API
+            uint64_t bypassed;      //!< volatile, forwarded to the API without caching
+        };
+
+        PropertyCache();
+        ~PropertyCache();
+
+        int getParamStruct(const std::string& target, const std::string& command, std::string& value);
+        int getParamXML(const std::string& target, const std::string& command, std::string& value);
+
+        int setParamStruct(const std::string& target, const std::string& command, const std::string& value);
+        int setParam_i32(int board_no, int command, int value);
+
+        /**
+         * Never cache queries with this command or target path element.
+         * @param name is matched ignoring case, a trailing '*' matches as prefix
+         */
+        void addVolatile(const std::string& name);
+        bool isVolatile(const std::string& target, const std::string& command) const;
+
+        /**
+         * Read and index the BoardProperties document of a board.
+         * Done implicitly by the first BoardProperties query.
+         */
+        int prefetch(int board_no);
+        bool isPrefetched(int board_no) const;
+
+        /**
+         * Drop the cached values of one board. Capability data is
+         * dropped as well if keep_capabilities is false.
+         */
+        void invalidate(int board_no, bool keep_capabilities = true);
+
+        /**
+         * Drop everything.
+         */
+        void clear();
+
+        Statistics getStatistics() const;
+
+    private:
+        typedef std::pair<std::string, std::string> Key;
+
+        struct BoardCache
+        {
+            std::map<Key, std::string> values;
+            std::map<Key, std::string> xml_values;
+            std::map<Key, std::string> capabilities;
+            std::unique_ptr<pugi::xml_document> properties;
+        };
+
+        bool queryProperties(BoardCache& cache, const std::string& path, const std::string& command,
+            std::string& value);
+        void invalidateTarget(int board_no);
+        void invalidateCommand(int board_no, int command);
+        void invalidateLocked(int board_no, bool keep_capabilities);
+        bool isVolatileLocked(const std::string& target, const std::string& command) const;
+
+    private:
+        mutable std::mutex m_mutex;
+        std::map<int, BoardCache> m_boards;
+        std::set<std::string> m_volatile;   //!< lower case
+        Statistics m_stats;
+        uint64_t m_generation;              //!< incremented on every invalidation
+    };
+
+} // trion
@@ -0,0 +1,76 @@
+// Copyright (c) DEWETRON GmbH 2026
+#pragma once
+
+#include "trion_board_capabilities.h"
+#include <string>
+
+namespace trion
+{
+    /**
+     * Local validation of property settings against the
+     * BoardProperties XML document of one board.
+     *
+     * Targets are given without the "BoardIDn/" prefix, eg
+     * "AcqProp", "AI0" or "AIAll", as in DeWeSetParamStruct_str.
+     * Like in the API, targets and items are not case sensitive:
+     * "AIALL" addresses the same channels as "AIAll".
+     * Checked are: existence of the channel and property, read-only
+     * properties (Config="False" or "Derived"), enumerated values (IDn
+     * children) and ProgMin/ProgMax ranges of programmable properties.
+     *
+     * The document is parsed by BoardCapabilities.
+     */
+    class BoardPropertyValidator
+    {
+    public:
+        BoardPropertyValidator();
+
+        /**
+         * Load the document returned by DeWeGetParamStruct_str("BoardIDn", "BoardProperties").
+         * @return false if the document could not be parsed
+         */
+        bool load(const std::string& properties_xml);
+
+        bool isLoaded() const;
+
+        /**
+         * Validate one setting.
+         * @param target is the target without board prefix
+         * @param item is the property name
+         * @param value is the value to set
+         * @param mode is the channel mode the property is set for, empty to accept any mode
+         * @param message receives a description if the setting is invalid
+         * @return ERR_NONE or the API error code the setting would most likely fail with
+         */
+        int validate(const std::string& target, const std::string& item, const std::string& value,
+            const std::string& mode, std::string& message) const;
+
+        /**
+         * Access to the parsed capabilities.
+         */
+        const BoardCapabilities& getCapabilities() const;
+
+    private:
+        int validateChannel(const std::string& channel, const std::string& item, const std::string& value,
+            const std::string& mode, std::string& message) const;
+        int validateProperty(const std::string& channel, const std::string& mode, const std::string& item,
+            const std::string& value, std::string& message) const;
+
+    private:
+        BoardCapabilities m_caps;
+    };
+
+    /**
+     * Channel group targets like "AIAll" address all channels of one type.
+     * @param name is a target without board prefix
+     * @param prefix receives the channel type, eg "AI"
+     * @return true if name is a channel group
+     */
+    bool isChannelGroup(const std::string& name, std::string& prefix);
+
+    /**
+     * Check if a channel name (eg "AI3") belongs to a channel type prefix (eg "AI").
+     */
+    bool isChannelOfType(const char* channel_name, const std::string& prefix);
+
+} // trion
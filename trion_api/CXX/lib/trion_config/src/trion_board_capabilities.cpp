@@ -0,0 +1,546 @@
+// Copyright (c) DEWETRON GmbH 2026
+
+#include "trion_board_capabilities.h"
+#include "trion_config_xml.h"
+#include "trion_numeric_params.h"
+#include "trion_property_validator.h"
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cstring>
+#include <limits>
+
+namespace
+{
+    const std::string EMPTY_STRING;
+
+    /**
+     * Groups contain further elements that are not enumerated values.
+     */
+    bool isGroup(pugi::xml_node node)
+    {
+        for (pugi::xml_node child = node.first_child(); child; child = child.next_sibling())
+        {
+            if (child.type() == pugi::node_element && !trion::isIdNode(child))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * Number at the start of text, like "10" of "10 V", independent of the locale.
+     * @return the end of the number or nullptr
+     */
+    const char* parseLeadingNumber(const char* text, double& value)
+    {
+        while (std::isspace(static_cast<unsigned char>(*text)))
+        {
+            ++text;
+        }
+        if (text[0] == '+' && text[1] != '-')
+        {
+            ++text;
+        }
+        const char* end = text + std::strlen(text);
+        auto result = std::from_chars(text, end, value);
+        return result.ec == std::errc() ? result.ptr : nullptr;
+    }
+
+} // namespace
+
+
+namespace trion
+{
+    BoardCapabilities::BoardCapabilities()
+        : m_loaded(false)
+    {
+    }
+
+    bool BoardCapabilities::load(const std::string& properties_xml)
+    {
+        clear();
+
+        pugi::xml_document doc;
+        if (!doc.load_buffer(properties_xml.data(), properties_xml.size()))
+        {
+            return false;
+        }
+        pugi::xml_node root = doc.document_element();
+        pugi::xml_node acquisition = root.child("AcquisitionProperties");
+        pugi::xml_node channels = root.child("ChannelProperties");
+        if (!acquisition && !channels)
+        {
+            return false;
+        }
+
+        for (pugi::xml_node group = acquisition.first_child(); group; group = group.next_sibling())
+        {
+            if (group.type() == pugi::node_element)
+            {
+                addAcquisitionGroup(group, group.name());
+            }
+        }
+        for (pugi::xml_node channel = channels.first_child(); channel; channel = channel.next_sibling())
+        {
+            if (channel.type() == pugi::node_element)
+            {
+                addChannel(channel);
+            }
+        }
+
+        m_loaded = true;
+        return true;
+    }
+
+    bool BoardCapabilities::isLoaded() const
+    {
+        return m_loaded;
+    }
+
+    void BoardCapabilities::clear()
+    {
+        m_strings.clear();
+        m_string_ids.clear();
+        m_lower_ids.clear();
+        m_channels.clear();
+        m_modes.clear();
+        m_properties.clear();
+        m_values.clear();
+        m_channel_index.clear();
+        m_property_index.clear();
+        m_loaded = false;
+    }
+
+    bool BoardCapabilities::hasChannel(const std::string& channel) const
+    {
+        return findChannel(channel) != nullptr;
+    }
+
+    std::size_t BoardCapabilities::getChannelCount(const std::string& prefix) const
+    {
+        std::size_t count = 0;
+        for (const Channel& channel : m_channels)
+        {
+            if (isChannelOfType(m_strings[channel.name].c_str(), prefix))
+            {
+                ++count;
+            }
+        }
+        return count;
+    }
+
+    std::vector<std::string> BoardCapabilities::getChannels(const std::string& prefix) const
+    {
+        std::vector<std::string> names;
+        for (const Channel& channel : m_channels)
+        {
+            if (isChannelOfType(m_strings[channel.name].c_str(), prefix))
+            {
+                names.push_back(m_strings[channel.name]);
+            }
+        }
+        return names;
+    }
+
+    std::size_t BoardCapabilities::getModeCount(const std::string& channel) const
+    {
+        const Channel* ch = findChannel(channel);
+        return ch ? ch->modes_end - ch->modes_begin : 0;
+    }
+
+    const std::string& BoardCapabilities::getModeName(const std::string& channel, std::size_t index) const
+    {
+        const Channel* ch = findChannel(channel);
+        if (!ch || index >= ch->modes_end - ch->modes_begin)
+        {
+            return EMPTY_STRING;
+        }
+        return m_strings[m_modes[ch->modes_begin + index].name];
+    }
+
+    bool BoardCapabilities::hasMode(const std::string& channel, const std::string& mode) const
+    {
+        const Channel* ch = findChannel(channel);
+        const uint32_t mode_name = lookup(mode);
+        if (!ch || mode_name == NO_STRING)
+        {
+            return false;
+        }
+        for (uint32_t m = ch->modes_begin; m < ch->modes_end; ++m)
+        {
+            if (m_modes[m].name == mode_name)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool BoardCapabilities::hasProperty(const std::string& channel, const std::string& mode, const std::string& item) const
+    {
+        return findProperty(channel, mode, item) != nullptr;
+    }
+
+    bool BoardCapabilities::isProgrammable(const std::string& channel, const std::string& mode, const std::string& item) const
+    {
+        const Property* property = findProperty(channel, mode, item);
+        return property && (property->flags & PROGRAMMABLE);
+    }
+
+    bool BoardCapabilities::isReadOnly(const std::string& channel, const std::string& mode, const std::string& item) const
+    {
+        const Property* property = findProperty(channel, mode, item);
+        return property && (property->flags & READ_ONLY);
+    }
+
+    std::size_t BoardCapabilities::getValueCount(const std::string& channel, const std::string& mode, const std::string& item) const
+    {
+        const Property* property = findProperty(channel, mode, item);
+        return property ? property->values_end - property->values_begin : 0;
+    }
+
+    const std::string& BoardCapabilities::getValue(const std::string& channel, const std::string& mode, const std::string& item,
+        std::size_t index) const
+    {
+        const Property* property = findProperty(channel, mode, item);
+        if (!property || index >= property->values_end - property->values_begin)
+        {
+            return EMPTY_STRING;
+        }
+        return m_strings[m_values[property->values_begin + index]];
+    }
+
+    std::vector<std::string> BoardCapabilities::getValues(const std::string& channel, const std::string& mode, const std::string& item) const
+    {
+        std::vector<std::string> values;
+        const Property* property = findProperty(channel, mode, item);
+        if (property)
+        {
+            for (uint32_t v = property->values_begin; v < property->values_end; ++v)
+            {
+                values.push_back(m_strings[m_values[v]]);
+            }
+        }
+        return values;
+    }
+
+    std::vector<double> BoardCapabilities::getNumericValues(const std::string& channel, const std::string& mode, const std::string& item) const
+    {
+        std::vector<double> values;
+        const Property* property = findProperty(channel, mode, item);
+        if (property)
+        {
+            for (uint32_t v = property->values_begin; v < property->values_end; ++v)
+            {
+                double number;
+                if (parseNumber(m_strings[m_values[v]].c_str(), number))
+                {
+                    values.push_back(number);
+                }
+            }
+        }
+        return values;
+    }
+
+    bool BoardCapabilities::getLimits(const std::string& channel, const std::string& mode, const std::string& item,
+        double& min_value, double& max_value) const
+    {
+        const Property* property = findProperty(channel, mode, item);
+        if (!property)
+        {
+            return false;
+        }
+        if (property->flags & HAS_LIMITS)
+        {
+            min_value = property->prog_min;
+            max_value = property->prog_max;
+            return true;
+        }
+
+        std::vector<double> values = getNumericValues(channel, mode, item);
+        if (values.empty())
+        {
+            return false;
+        }
+        auto bounds = std::minmax_element(values.begin(), values.end());
+        min_value = *bounds.first;
+        max_value = *bounds.second;
+        return true;
+    }
+
+    bool BoardCapabilities::getRangeLimits(const std::string& channel, const std::string& mode,
+        double& min_value, double& max_value) const
+    {
+        const Property* property = findProperty(channel, mode, "Range");
+        if (!property)
+        {
+            return false;
+        }
+
+        bool found = false;
+        min_value = std::numeric_limits<double>::max();
+        max_value = std::numeric_limits<double>::lowest();
+        for (uint32_t v = property->values_begin; v < property->values_end; ++v)
+        {
+            double rmin, rmax;
+            if (parseRange(m_strings[m_values[v]].c_str(), rmin, rmax))
+            {
+                min_value = std::min(min_value, rmin);
+                max_value = std::max(max_value, rmax);
+                found = true;
+            }
+        }
+        if (property->flags & HAS_LIMITS)
+        {
+            min_value = found ? std::min(min_value, -property->prog_max) : -property->prog_max;
+            max_value = found ? std::max(max_value, property->prog_max) : property->prog_max;
+            found = true;
+        }
+        return found;
+    }
+
+    bool BoardCapabilities::isValidValue(const std::string& channel, const std::string& mode, const std::string& item,
+        const std::string& value) const
+    {
+        const Property* property = findProperty(channel, mode, item);
+        if (!property)
+        {
+            return false;
+        }
+
+        double number = 0;
+        const bool numeric = parseNumber(value.c_str(), number);
+        const uint32_t value_id = lookup(value);
+        for (uint32_t v = property->values_begin; v < property->values_end; ++v)
+        {
+            if (m_values[v] == value_id)
+            {
+                return true;
+            }
+            double id_number;
+            if (numeric && parseNumber(m_strings[m_values[v]].c_str(), id_number) && id_number == number)
+            {
+                return true;
+            }
+        }
+
+        const bool programmable = (property->flags & PROGRAMMABLE) || property->values_begin == property->values_end;
+        if (programmable && (property->flags & HAS_LIMITS) && numeric)
+        {
+            return number >= property->prog_min && number <= property->prog_max;
+        }
+        return programmable;
+    }
+
+    bool BoardCapabilities::parseRange(const char* text, double& min_value, double& max_value)
+    {
+        if (!text)
+        {
+            return false;
+        }
+        double first = 0;
+        const char* end = parseLeadingNumber(text, first);
+        if (!end)
+        {
+            return false;
+        }
+        // "-5..10" may be parsed as "-5." and ".10"
+        if (end > text && end[-1] == '.' && end[0] == '.')
+        {
+            --end;
+        }
+        while (std::isspace(static_cast<unsigned char>(*end)))
+        {
+            ++end;
+        }
+        if (end[0] == '.' && end[1] == '.')
+        {
+            double second = 0;
+            if (!parseLeadingNumber(end + 2, second))
+            {
+                return false;
+            }
+            min_value = first;
+            max_value = second;
+        }
+        else
+        {
+            min_value = -first;
+            max_value = first;
+        }
+        return true;
+    }
+
+    uint32_t BoardCapabilities::intern(const char* text)
+    {
+        auto it = m_string_ids.find(text);
+        if (it != m_string_ids.end())
+        {
+            return it->second;
+        }
+        const uint32_t id = static_cast<uint32_t>(m_strings.size());
+        m_strings.push_back(text);
+        m_string_ids.emplace(m_strings.back(), id);
+        m_lower_ids.emplace(toLower(m_strings.back()), id);
+        return id;
+    }
+
+    uint32_t BoardCapabilities::lookup(const std::string& text) const
+    {
+        auto it = m_string_ids.find(text);
+        if (it != m_string_ids.end())
+        {
+            return it->second;
+        }
+        it = m_lower_ids.find(toLower(text));
+        return it != m_lower_ids.end() ? it->second : NO_STRING;
+    }
+
+    const BoardCapabilities::Channel* BoardCapabilities::findChannel(const std::string& channel) const
+    {
+        auto it = m_channel_index.find(lookup(channel));
+        return it != m_channel_index.end() ? &m_channels[it->second] : nullptr;
+    }
+
+    const BoardCapabilities::Property* BoardCapabilities::findProperty(const std::string& channel,
+        const std::string& mode, const std::string& item) const
+    {
+        auto ch_it = m_channel_index.find(lookup(channel));
+        const uint32_t name = lookup(item);
+        if (ch_it == m_channel_index.end() || name == NO_STRING)
+        {
+            return nullptr;
+        }
+
+        // mode slot 0 is the channel level
+        uint32_t mode_slot = 0;
+        if (!mode.empty())
+        {
+            const Channel& ch = m_channels[ch_it->second];
+            const uint32_t mode_name = lookup(mode);
+            uint32_t m = ch.modes_begin;
+            while (m < ch.modes_end && m_modes[m].name != mode_name)
+            {
+                ++m;
+            }
+            if (m == ch.modes_end)
+            {
+                return nullptr;
+            }
+            mode_slot = m + 1;
+        }
+
+        auto it = m_property_index.find(propertyKey(ch_it->second, mode_slot, name));
+        return it != m_property_index.end() ? &m_properties[it->second] : nullptr;
+    }
+
+    uint64_t BoardCapabilities::propertyKey(uint32_t channel, uint32_t mode, uint32_t name)
+    {
+        return (static_cast<uint64_t>(channel) << 44) | (static_cast<uint64_t>(mode) << 22) | name;
+    }
+
+    void BoardCapabilities::addProperty(pugi::xml_node node, uint32_t channel, uint32_t mode)
+    {
+        Property property = {};
+        property.name = intern(node.name());
+        property.values_begin = static_cast<uint32_t>(m_values.size());
+        for (pugi::xml_node id = node.first_child(); id; id = id.next_sibling())
+        {
+            if (isIdNode(id))
+            {
+                m_values.push_back(intern(id.child_value()));
+            }
+        }
+        property.values_end = static_cast<uint32_t>(m_values.size());
+
+        const char* programmable = node.attribute("Programmable").value();
+        if (std::strcmp(programmable, "True") == 0 || std::strcmp(programmable, "true") == 0)
+        {
+            property.flags |= PROGRAMMABLE;
+        }
+        const char* config = node.attribute("Config").value();
+        if (std::strcmp(config, "False") == 0 || std::strcmp(config, "Derived") == 0)
+        {
+            property.flags |= READ_ONLY;
+        }
+        if (parseNumber(node.attribute("ProgMin").value(), property.prog_min)
+            && parseNumber(node.attribute("ProgMax").value(), property.prog_max))
+        {
+            property.flags |= HAS_LIMITS;
+        }
+
+        m_property_index[propertyKey(channel, mode, property.name)] = static_cast<uint32_t>(m_properties.size());
+        m_properties.push_back(property);
+    }
+
+    void BoardCapabilities::addAcquisitionGroup(pugi::xml_node group, const std::string& path)
+    {
+        Channel channel = {};
+        channel.name = intern(path.c_str());
+        const uint32_t index = static_cast<uint32_t>(m_channels.size());
+        m_channel_index[channel.name] = index;
+        m_channels.push_back(channel);
+
+        for (pugi::xml_node node = group.first_child(); node; node = node.next_sibling())
+        {
+            if (node.type() != pugi::node_element)
+            {
+                continue;
+            }
+            if (isGroup(node))
+            {
+                addAcquisitionGroup(node, path + "/" + node.name());
+            }
+            else
+            {
+                addProperty(node, index, 0);
+            }
+        }
+    }
+
+    void BoardCapabilities::addChannel(pugi::xml_node node)
+    {
+        Channel channel = {};
+        channel.name = intern(node.name());
+        const uint32_t index = static_cast<uint32_t>(m_channels.size());
+        m_channel_index[channel.name] = index;
+
+        // modes are stored contiguously per channel
+        channel.modes_begin = static_cast<uint32_t>(m_modes.size());
+        for (pugi::xml_node m = node.child("Mode"); m; m = m.next_sibling("Mode"))
+        {
+            Mode mode = {};
+            mode.name = intern(m.attribute("Mode").value());
+            m_modes.push_back(mode);
+        }
+        channel.modes_end = static_cast<uint32_t>(m_modes.size());
+        m_channels.push_back(channel);
+
+        uint32_t mode_slot = channel.modes_begin + 1;
+        for (pugi::xml_node child = node.first_child(); child; child = child.next_sibling())
+        {
+            if (child.type() != pugi::node_element)
+            {
+                continue;
+            }
+            if (std::strcmp(child.name(), "Mode") == 0)
+            {
+                for (pugi::xml_node property = child.first_child(); property; property = property.next_sibling())
+                {
+                    if (property.type() == pugi::node_element && !isGroup(property))
+                    {
+                        addProperty(property, index, mode_slot);
+                    }
+                }
+                ++mode_slot;
+            }
+            else if (!isGroup(child))
+            {
+                addProperty(child, index, 0);
+            }
+        }
+    }
+
+} // trion
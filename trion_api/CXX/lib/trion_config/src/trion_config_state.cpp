@@ -0,0 +1,461 @@
+// Copyright (c) DEWETRON GmbH 2026
+
+#include "trion_config_state.h"
+#include "trion_config_xml.h"
+#include "dewepxi_apicxx.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <set>
+
+namespace
+{
+    const char ACQ_TARGET[] = "AcqProp";
+
+    struct ChannelCommand
+    {
+        const char* prefix;
+        int command;
+        bool per_channel;
+    };
+
+    const ChannelCommand CHANNEL_COMMANDS[] =
+    {
+        { "AI",       CMD_UPDATE_PARAM_AI,        true },
+        { "CNT",      CMD_UPDATE_PARAM_CNT,       false },
+        { "BoardCNT", CMD_UPDATE_PARAM_BOARD_CNT, false },
+        { "Discret",  CMD_UPDATE_PARAM_DI,        false },
+        { "CAN",      CMD_UPDATE_PARAM_CAN,       false },
+        { "CANFD",    CMD_UPDATE_PARAM_CANFD,     false },
+        { "UART",     CMD_UPDATE_PARAM_UART,      false },
+        { "ARef",     CMD_UPDATE_PARAM_AREF,      false },
+    };
+
+    const char* const TIMING_ITEMS[] =
+    {
+        "OperationMode", "ExtTrigger", "ExtClk"
+    };
+
+    const char MODE_ITEM[] = "Mode";
+
+    /**
+     * Lower case copy, targets and items are not case sensitive
+     */
+    std::string toLower(std::string text)
+    {
+        for (char& c : text)
+        {
+            c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        }
+        return text;
+    }
+
+    bool isAcqCommand(int command)
+    {
+        return command == CMD_UPDATE_PARAM_ACQ
+            || command == CMD_UPDATE_PARAM_ACQ_SR
+            || command == CMD_UPDATE_PARAM_ACQ_TIMING
+            || command == CMD_UPDATE_PARAM_ACQ_ALL;
+    }
+
+    int classifyAcquisition(const std::string& path, const std::string& item)
+    {
+        const std::string lower_path = toLower(path);
+        if (lower_path.find("/syncsettings") != std::string::npos || lower_path.find("/timing") != std::string::npos)
+        {
+            return CMD_UPDATE_PARAM_ACQ_TIMING;
+        }
+        for (const char* timing : TIMING_ITEMS)
+        {
+            if (trion::equalsNoCase(item.c_str(), timing))
+            {
+                return CMD_UPDATE_PARAM_ACQ_TIMING;
+            }
+        }
+        if (trion::equalsNoCase(item, "SampleRate"))
+        {
+            return CMD_UPDATE_PARAM_ACQ_SR;
+        }
+        return CMD_UPDATE_PARAM_ACQ;
+    }
+
+    /**
+     * Split a channel target like "AI3" or "AIAll" into type and channel index.
+     * @param index receives the channel index or UPDATE_ALL_CHANNELS for groups
+     */
+    bool splitChannel(const std::string& path, std::string& prefix, int& index)
+    {
+        std::string name = path.substr(0, path.find('/'));
+        if (trion::isChannelGroup(name, prefix))
+        {
+            index = UPDATE_ALL_CHANNELS;
+            return true;
+        }
+        std::size_t pos = name.size();
+        while (pos > 0 && std::isdigit(static_cast<unsigned char>(name[pos - 1])))
+        {
+            --pos;
+        }
+        if (pos == 0 || pos == name.size())
+        {
+            return false;
+        }
+        prefix = name.substr(0, pos);
+        index = std::atoi(name.c_str() + pos);
+        return true;
+    }
+
+} // namespace
+
+
+namespace trion
+{
+    void ConfigState::set(const std::string& target, const std::string& item, const std::string& value)
+    {
+        Key key(toLower(target), toLower(item));
+        auto it = m_index.find(key);
+        if (it != m_index.end())
+        {
+            m_entries[it->second].value = value;
+            return;
+        }
+        ConfigEntry entry;
+        entry.target = target;
+        entry.item = item;
+        entry.value = value;
+        m_index[key] = m_entries.size();
+        m_entries.push_back(entry);
+    }
+
+    bool ConfigState::get(const std::string& target, const std::string& item, std::string& value) const
+    {
+        auto it = m_index.find(Key(toLower(target), toLower(item)));
+        if (it == m_index.end())
+        {
+            return false;
+        }
+        value = m_entries[it->second].value;
+        return true;
+    }
+
+    void ConfigState::eraseBoard(int board_no)
+    {
+        std::vector<ConfigEntry> entries;
+        entries.swap(m_entries);
+        m_index.clear();
+        for (const ConfigEntry& entry : entries)
+        {
+            int no;
+            std::string path;
+            if (!parseBoardTarget(entry.target, no, path) || no != board_no)
+            {
+                set(entry.target, entry.item, entry.value);
+            }
+        }
+    }
+
+    void ConfigState::clear()
+    {
+        m_entries.clear();
+        m_index.clear();
+    }
+
+    std::size_t ConfigState::size() const
+    {
+        return m_entries.size();
+    }
+
+    const std::vector<ConfigEntry>& ConfigState::getEntries() const
+    {
+        return m_entries;
+    }
+
+    std::vector<ConfigEntry> ConfigState::diff(const ConfigState& applied) const
+    {
+        const std::size_t count = m_entries.size();
+        std::vector<bool> changed(count, true);
+        // lower case "board/channel" or "board/type" of channel entries, empty otherwise
+        std::vector<std::string> channels(count);
+        std::vector<std::string> groups(count);
+
+        // first pass: changed entries, changed group settings and changed modes
+        std::map<Key, std::size_t> changed_groups;      // (board/type, item) -> position
+        std::map<std::string, std::size_t> changed_modes;   // board/channel or board/type -> position
+        for (std::size_t n = 0; n < count; ++n)
+        {
+            const ConfigEntry& entry = m_entries[n];
+            std::string value;
+            if (applied.get(entry.target, entry.item, value))
+            {
+                changed[n] = (value != entry.value);
+            }
+
+            int board_no;
+            std::string path;
+            std::string prefix;
+            int index;
+            if (!parseBoardTarget(entry.target, board_no, path) || !splitChannel(path, prefix, index))
+            {
+                continue;
+            }
+            const std::string board = std::to_string(board_no) + "/";
+            groups[n] = toLower(board + prefix);
+            channels[n] = index == UPDATE_ALL_CHANNELS ? groups[n] : toLower(board + path.substr(0, path.find('/')));
+
+            if (!changed[n])
+            {
+                continue;
+            }
+            if (index == UPDATE_ALL_CHANNELS)
+            {
+                changed_groups[Key(groups[n], toLower(entry.item))] = n;
+            }
+            if (equalsNoCase(entry.item, MODE_ITEM))
+            {
+                changed_modes[channels[n]] = n;
+            }
+        }
+
+        // second pass: an entry overwritten by a changed group setting or
+        // reset by a changed mode is applied again, after that setting
+        std::vector<std::pair<std::size_t, std::size_t>> order;    // (sort position, entry)
+        for (std::size_t n = 0; n < count; ++n)
+        {
+            std::size_t after = 0;
+            bool dominated = false;
+            if (!channels[n].empty())
+            {
+                const bool is_mode = equalsNoCase(m_entries[n].item, MODE_ITEM);
+                auto group = changed_groups.find(Key(groups[n], toLower(m_entries[n].item)));
+                if (group != changed_groups.end() && group->second != n)
+                {
+                    dominated = true;
+                    after = std::max(after, group->second);
+                }
+                auto mode = changed_modes.find(groups[n]);
+                if (!is_mode && mode != changed_modes.end())
+                {
+                    dominated = true;
+                    after = std::max(after, mode->second);
+                }
+                mode = changed_modes.find(channels[n]);
+                if (!is_mode && mode != changed_modes.end())
+                {
+                    dominated = true;
+                    after = std::max(after, mode->second);
+                }
+            }
+            if (!changed[n] && !dominated)
+            {
+                continue;
+            }
+            // 2 * n keeps the own position, 2 * after + 1 sorts behind the dominating entry
+            order.push_back(std::make_pair(dominated && after > n ? 2 * after + 1 : 2 * n, n));
+        }
+        std::stable_sort(order.begin(), order.end(),
+            [](const std::pair<std::size_t, std::size_t>& a, const std::pair<std::size_t, std::size_t>& b)
+        {
+            return a.first < b.first;
+        });
+
+        std::vector<ConfigEntry> changes;
+        changes.reserve(order.size());
+        for (const auto& o : order)
+        {
+            changes.push_back(m_entries[o.second]);
+        }
+        return changes;
+    }
+
+
+    std::vector<UpdateCommand> selectUpdateCommands(const std::vector<ConfigEntry>& changes)
+    {
+        std::vector<UpdateCommand> commands;
+        // command -> channel index (UPDATE_ALL_CHANNELS if more than one)
+        std::map<int, int> selected;
+
+        for (const ConfigEntry& entry : changes)
+        {
+            int board_no;
+            std::string path;
+            if (!parseBoardTarget(entry.target, board_no, path))
+            {
+                continue;
+            }
+
+            std::string prefix;
+            int index = 0;
+            int command = CMD_UPDATE_PARAM_ALL;
+            bool per_channel = false;
+
+            if (equalsNoCase(path.substr(0, sizeof(ACQ_TARGET) - 1), ACQ_TARGET))
+            {
+                command = classifyAcquisition(path, entry.item);
+            }
+            else if (!equalsNoCase(entry.item, "Used") && splitChannel(path, prefix, index))
+            {
+                for (const ChannelCommand& cc : CHANNEL_COMMANDS)
+                {
+                    if (equalsNoCase(prefix.c_str(), cc.prefix))
+                    {
+                        command = cc.command;
+                        per_channel = cc.per_channel;
+                        break;
+                    }
+                }
+            }
+
+            if (command == CMD_UPDATE_PARAM_ALL)
+            {
+                commands.clear();
+                commands.push_back(UpdateCommand{ CMD_UPDATE_PARAM_ALL, 0 });
+                return commands;
+            }
+
+            const int value = per_channel ? index : 0;
+            auto it = selected.find(command);
+            if (it == selected.end())
+            {
+                selected[command] = value;
+            }
+            else if (it->second != value)
+            {
+                it->second = UPDATE_ALL_CHANNELS;
+            }
+        }
+
+        // acquisition settings first, merged if more than one command is needed
+        const std::size_t acq_count = std::count_if(selected.begin(), selected.end(),
+            [](const std::pair<const int, int>& s) { return isAcqCommand(s.first); });
+        if (acq_count > 1)
+        {
+            commands.push_back(UpdateCommand{ CMD_UPDATE_PARAM_ACQ_ALL, 0 });
+        }
+        for (const auto& s : selected)
+        {
+            if (acq_count == 1 && isAcqCommand(s.first))
+            {
+                commands.push_back(UpdateCommand{ s.first, s.second });
+            }
+        }
+        for (const auto& s : selected)
+        {
+            if (!isAcqCommand(s.first))
+            {
+                commands.push_back(UpdateCommand{ s.first, s.second });
+            }
+        }
+        return commands;
+    }
+
+
+    void ConfigStateTracker::plan(const ConfigState& desired, std::vector<ConfigEntry>& changes,
+        std::map<int, std::vector<UpdateCommand>>& commands) const
+    {
+        changes = desired.diff(m_applied);
+
+        std::map<int, std::vector<ConfigEntry>> boards;
+        for (const ConfigEntry& entry : changes)
+        {
+            int board_no;
+            std::string path;
+            if (parseBoardTarget(entry.target, board_no, path))
+            {
+                boards[board_no].push_back(entry);
+            }
+        }
+
+        commands.clear();
+        for (const auto& board : boards)
+        {
+            commands[board.first] = selectUpdateCommands(board.second);
+        }
+    }
+
+    int ConfigStateTracker::apply(const ConfigState& desired, std::vector<ConfigIssue>* issues)
+    {
+        std::vector<ConfigEntry> changes;
+        std::map<int, std::vector<UpdateCommand>> commands;
+        plan(desired, changes, commands);
+
+        int result = ERR_NONE;
+        std::set<int> failed_boards;
+        for (const ConfigEntry& entry : changes)
+        {
+            int err = DeWeSetParamStruct_str_s(entry.target, entry.item, entry.value);
+            if (err == ERR_NONE)
+            {
+                m_applied.set(entry.target, entry.item, entry.value);
+                continue;
+            }
+
+            if (issues)
+            {
+                ConfigIssue issue;
+                issue.entry = entry;
+                issue.error = err;
+                issues->push_back(issue);
+            }
+            if (result == ERR_NONE)
+            {
+                result = err;
+            }
+            // the board now holds an unknown mix of old and new values
+            int board_no;
+            std::string path;
+            if (parseBoardTarget(entry.target, board_no, path))
+            {
+                failed_boards.insert(board_no);
+            }
+        }
+
+        for (const auto& board : commands)
+        {
+            for (const UpdateCommand& cmd : board.second)
+            {
+                int err = DeWeSetParam_i32(board.first, cmd.command, cmd.value);
+                if (err == ERR_NONE)
+                {
+                    continue;
+                }
+                if (issues)
+                {
+                    ConfigIssue issue;
+                    issue.entry.target = "BoardID" + std::to_string(board.first);
+                    issue.entry.item = "CMD_UPDATE_PARAM";
+                    issue.entry.value = std::to_string(cmd.command);
+                    issue.error = err;
+                    issues->push_back(issue);
+                }
+                if (result == ERR_NONE)
+                {
+                    result = err;
+                }
+                failed_boards.insert(board.first);
+            }
+        }
+
+        for (int board_no : failed_boards)
+        {
+            invalidate(board_no);
+        }
+        return result;
+    }
+
+    void ConfigStateTracker::invalidate(int board_no)
+    {
+        m_applied.eraseBoard(board_no);
+    }
+
+    void ConfigStateTracker::invalidate()
+    {
+        m_applied.clear();
+    }
+
+    const ConfigState& ConfigStateTracker::getApplied() const
+    {
+        return m_applied;
+    }
+
+} // trion
@@ -0,0 +1,516 @@
+// Copyright (c) DEWETRON GmbH 2026
+
+#include "trion_config_transaction.h"
+#include "trion_config_xml.h"
+#include "dewepxi_apicxx.h"
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <set>
+
+namespace
+{
+    const char BOARD_PREFIX[] = "BoardID";
+    const char CONFIG_COMMAND[] = "config";
+    const char CONFIG_RESULT_COMMAND[] = "configresult";
+    const char PROPERTIES_COMMAND[] = "BoardProperties";
+    const char ACQ_TARGET[] = "AcqProp";
+
+    /**
+     * pugixml writer appending to a std::string
+     */
+    class StringWriter : public pugi::xml_writer
+    {
+    public:
+        explicit StringWriter(std::string& out)
+            : m_out(out)
+        {
+        }
+
+        void write(const void* data, size_t size) override
+        {
+            m_out.append(static_cast<const char*>(data), size);
+        }
+
+    private:
+        std::string& m_out;
+    };
+
+    std::string boardTarget(int board_no)
+    {
+        return BOARD_PREFIX + std::to_string(board_no);
+    }
+
+    bool hasElementChild(pugi::xml_node node)
+    {
+        for (pugi::xml_node child = node.first_child(); child; child = child.next_sibling())
+        {
+            if (child.type() == pugi::node_element)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * Locate the configuration nodes addressed by a target path
+     */
+    void findConfigNodes(pugi::xml_node root, const std::string& path, std::vector<pugi::xml_node>& nodes)
+    {
+        // "AcqProp" maps onto the Acquisition section itself
+        pugi::xml_node acq = trion::walk(root.child("Acquisition"), path);
+        if (!acq && trion::equalsNoCase(path.substr(0, sizeof(ACQ_TARGET) - 1), ACQ_TARGET))
+        {
+            std::string rest = path.substr(sizeof(ACQ_TARGET) - 1);
+            if (rest.empty() || rest[0] == '/')
+            {
+                acq = trion::walk(root.child("Acquisition"), rest.empty() ? rest : rest.substr(1));
+            }
+        }
+        if (acq)
+        {
+            nodes.push_back(acq);
+            return;
+        }
+
+        pugi::xml_node channels = root.child("Channel");
+        std::string prefix;
+        if (trion::isChannelGroup(path, prefix))
+        {
+            for (pugi::xml_node ch = channels.first_child(); ch; ch = ch.next_sibling())
+            {
+                if (trion::isChannelOfType(ch.name(), prefix))
+                {
+                    nodes.push_back(ch);
+                }
+            }
+            return;
+        }
+
+        pugi::xml_node ch = trion::walk(channels, path);
+        if (ch)
+        {
+            nodes.push_back(ch);
+        }
+    }
+
+    /**
+     * Set a property in the configuration document.
+     * @return false if the property is not present in the document
+     */
+    bool mergeEntry(pugi::xml_node root, const trion::ConfigEntry& entry, const std::string& path)
+    {
+        std::vector<pugi::xml_node> nodes;
+        findConfigNodes(root, path, nodes);
+        if (nodes.empty())
+        {
+            return false;
+        }
+        for (pugi::xml_node node : nodes)
+        {
+            if (!trion::findChild(node, entry.item.c_str()) && !trion::findAttribute(node, entry.item.c_str()))
+            {
+                return false;
+            }
+        }
+        for (pugi::xml_node node : nodes)
+        {
+            pugi::xml_node child = trion::findChild(node, entry.item.c_str());
+            if (child)
+            {
+                child.text().set(entry.value.c_str());
+            }
+            else
+            {
+                trion::findAttribute(node, entry.item.c_str()).set_value(entry.value.c_str());
+            }
+        }
+        return true;
+    }
+
+    /**
+     * Collect the per property results of the last "config" load.
+     * The result document has the layout of the configuration document,
+     * with texts like "Error 120012, ERROR_AI_CHANNEL_NOT_VALID (120012)"
+     * or "Warning -190910, WARNING_STARTCONDITION_NOT_USED (-190910)".
+     * @param config is the matching node of the loaded configuration, for the values
+     */
+    void collectResults(pugi::xml_node node, const std::string& target, pugi::xml_node config,
+        std::vector<trion::ConfigIssue>& issues)
+    {
+        for (pugi::xml_node child = node.first_child(); child; child = child.next_sibling())
+        {
+            if (child.type() != pugi::node_element)
+            {
+                continue;
+            }
+            if (hasElementChild(child))
+            {
+                collectResults(child, target + "/" + child.name(), trion::findChild(config, child.name()), issues);
+                continue;
+            }
+
+            const char* text = child.child_value();
+            const char* number = std::strchr(text, ' ');
+            const int error = number ? std::atoi(number + 1) : 0;
+            if (error == ERR_NONE)
+            {
+                // depending on the API configuration successful settings are listed too
+                continue;
+            }
+            trion::ConfigIssue issue;
+            issue.entry.target = target;
+            issue.entry.item = child.name();
+            issue.entry.value = trion::findChild(config, child.name()).child_value();
+            issue.error = error;
+            issue.message = text;
+            issues.push_back(issue);
+        }
+    }
+
+} // namespace
+
+
+namespace trion
+{
+    bool parseBoardTarget(const std::string& target, int& board_no, std::string& path)
+    {
+        const std::size_t prefix_len = sizeof(BOARD_PREFIX) - 1;
+        if (!equalsNoCase(target.substr(0, prefix_len), BOARD_PREFIX))
+        {
+            return false;
+        }
+        std::size_t pos = prefix_len;
+        int number = 0;
+        while (pos < target.size() && std::isdigit(static_cast<unsigned char>(target[pos])))
+        {
+            number = number * 10 + (target[pos] - '0');
+            ++pos;
+        }
+        if (pos == prefix_len || (pos < target.size() && target[pos] != '/'))
+        {
+            return false;
+        }
+        board_no = number;
+        path = (pos < target.size()) ? target.substr(pos + 1) : std::string();
+        return true;
+    }
+
+
+    ConfigTransaction::ConfigTransaction()
+        : m_validate(true)
+    {
+    }
+
+    ConfigTransaction::~ConfigTransaction()
+    {
+    }
+
+    void ConfigTransaction::set(const std::string& target, const std::string& item, const std::string& value)
+    {
+        for (ConfigEntry& entry : m_entries)
+        {
+            if (equalsNoCase(entry.target, target) && equalsNoCase(entry.item, item))
+            {
+                entry.value = value;
+                return;
+            }
+        }
+        ConfigEntry entry;
+        entry.target = target;
+        entry.item = item;
+        entry.value = value;
+        m_entries.push_back(entry);
+    }
+
+    void ConfigTransaction::setBoardProperties(int board_no, const std::string& properties_xml)
+    {
+        std::unique_ptr<BoardPropertyValidator> validator(new BoardPropertyValidator());
+        validator->load(properties_xml);
+        m_validators[board_no] = std::move(validator);
+    }
+
+    void ConfigTransaction::setValidation(bool enable)
+    {
+        m_validate = enable;
+    }
+
+    int ConfigTransaction::validate(std::vector<ConfigIssue>& issues)
+    {
+        // channel mode set within this transaction, per target
+        std::map<std::string, std::string> modes;
+        for (const ConfigEntry& entry : m_entries)
+        {
+            if (equalsNoCase(entry.item, "Mode"))
+            {
+                modes[toLower(entry.target)] = entry.value;
+            }
+        }
+
+        int result = ERR_NONE;
+        for (const ConfigEntry& entry : m_entries)
+        {
+            int board_no;
+            std::string path;
+            if (!parseBoardTarget(entry.target, board_no, path) || path.empty())
+            {
+                continue;
+            }
+            BoardPropertyValidator* validator = getValidator(board_no);
+            if (!validator)
+            {
+                continue;
+            }
+
+            std::string mode;
+            auto it = modes.find(toLower(entry.target));
+            if (it != modes.end())
+            {
+                mode = it->second;
+            }
+            else
+            {
+                // a mode set for the channel group applies to the single channel
+                std::string prefix = path;
+                while (!prefix.empty() && std::isdigit(static_cast<unsigned char>(prefix.back())))
+                {
+                    prefix.pop_back();
+                }
+                it = modes.find(toLower(boardTarget(board_no) + "/" + prefix + "All"));
+                if (prefix != path && it != modes.end())
+                {
+                    mode = it->second;
+                }
+            }
+
+            ConfigIssue issue;
+            issue.error = validator->validate(path, entry.item, entry.value, mode, issue.message);
+            if (issue.error != ERR_NONE)
+            {
+                issue.entry = entry;
+                issues.push_back(issue);
+                if (result == ERR_NONE)
+                {
+                    result = issue.error;
+                }
+            }
+        }
+        return result;
+    }
+
+    int ConfigTransaction::commit(std::vector<ConfigIssue>* issues)
+    {
+        std::vector<ConfigIssue> local_issues;
+        std::vector<ConfigIssue>& out = issues ? *issues : local_issues;
+
+        if (m_validate)
+        {
+            int err = validate(out);
+            if (err != ERR_NONE)
+            {
+                return err;
+            }
+        }
+
+        int result = ERR_NONE;
+        std::map<int, std::vector<const ConfigEntry*>> boards;
+        for (const ConfigEntry& entry : m_entries)
+        {
+            int board_no;
+            std::string path;
+            if (parseBoardTarget(entry.target, board_no, path))
+            {
+                boards[board_no].push_back(&entry);
+            }
+            else
+            {
+                // global settings (eg network or api config) first
+                int err = applySingle(entry, out);
+                if (result == ERR_NONE)
+                {
+                    result = err;
+                }
+            }
+        }
+
+        for (auto& board : boards)
+        {
+            int err = applyBoard(board.first, board.second, out);
+            if (result == ERR_NONE)
+            {
+                result = err;
+            }
+        }
+
+        clear();
+        return result;
+    }
+
+    void ConfigTransaction::clear()
+    {
+        m_entries.clear();
+    }
+
+    std::size_t ConfigTransaction::size() const
+    {
+        return m_entries.size();
+    }
+
+    const std::vector<ConfigEntry>& ConfigTransaction::getEntries() const
+    {
+        return m_entries;
+    }
+
+    std::vector<int> ConfigTransaction::getBoards() const
+    {
+        std::set<int> boards;
+        for (const ConfigEntry& entry : m_entries)
+        {
+            int board_no;
+            std::string path;
+            if (parseBoardTarget(entry.target, board_no, path))
+            {
+                boards.insert(board_no);
+            }
+        }
+        return std::vector<int>(boards.begin(), boards.end());
+    }
+
+    BoardPropertyValidator* ConfigTransaction::getValidator(int board_no)
+    {
+        auto it = m_validators.find(board_no);
+        if (it == m_validators.end())
+        {
+            std::string properties_xml;
+            std::unique_ptr<BoardPropertyValidator> validator(new BoardPropertyValidator());
+            if (DeWeGetParamStruct_str_s(boardTarget(board_no), PROPERTIES_COMMAND, properties_xml) == ERR_NONE)
+            {
+                validator->load(properties_xml);
+            }
+            it = m_validators.emplace(board_no, std::move(validator)).first;
+        }
+        return it->second->isLoaded() ? it->second.get() : nullptr;
+    }
+
+    int ConfigTransaction::applyBoard(int board_no, const std::vector<const ConfigEntry*>& entries, std::vector<ConfigIssue>& issues)
+    {
+        const std::string target = boardTarget(board_no);
+        std::vector<const ConfigEntry*> singles;
+
+        std::string config_xml;
+        pugi::xml_document doc;
+        pugi::xml_node root;
+        bool merged = false;
+        if (DeWeGetParamStruct_str_s(target, CONFIG_COMMAND, config_xml) == ERR_NONE
+            && doc.load_buffer(config_xml.data(), config_xml.size()))
+        {
+            root = doc.document_element();
+            for (const ConfigEntry* entry : entries)
+            {
+                int no;
+                std::string path;
+                parseBoardTarget(entry->target, no, path);
+                if (!path.empty() && mergeEntry(root, *entry, path))
+                {
+                    merged = true;
+                }
+                else
+                {
+                    singles.push_back(entry);
+                }
+            }
+        }
+        else
+        {
+            singles = entries;
+        }
+
+        int result = ERR_NONE;
+        if (merged)
+        {
+            config_xml.clear();
+            StringWriter writer(config_xml);
+            doc.save(writer, "", pugi::format_raw | pugi::format_no_declaration);
+
+            int err = DeWeSetParamStruct_str_s(target, CONFIG_COMMAND, config_xml);
+            if (err != ERR_NONE)
+            {
+                // the load is greedy, the result document has the outcome of every setting
+                const std::size_t first_issue = issues.size();
+                std::string result_xml;
+                pugi::xml_document results;
+                if (DeWeGetParamStruct_str_s(target, CONFIG_RESULT_COMMAND, result_xml) == ERR_NONE
+                    && results.load_buffer(result_xml.data(), result_xml.size()))
+                {
+                    for (pugi::xml_node section = results.document_element().first_child(); section; section = section.next_sibling())
+                    {
+                        collectResults(section, target, root.child(section.name()), issues);
+                    }
+                }
+
+                if (issues.size() > first_issue)
+                {
+                    for (std::size_t n = first_issue; n < issues.size(); ++n)
+                    {
+                        if (issues[n].error > 0 && result == ERR_NONE)
+                        {
+                            result = issues[n].error;
+                        }
+                    }
+                }
+                else if (err > 0)
+                {
+                    // document rejected as a whole: fall back to individual settings
+                    singles = entries;
+                }
+                else
+                {
+                    ConfigIssue issue;
+                    issue.entry.target = target;
+                    issue.entry.item = CONFIG_COMMAND;
+                    issue.error = err;
+                    issues.push_back(issue);
+                }
+            }
+        }
+
+        for (const ConfigEntry* entry : singles)
+        {
+            int err = applySingle(*entry, issues);
+            if (result == ERR_NONE)
+            {
+                result = err;
+            }
+        }
+
+        int err = DeWeSetParam_i32(board_no, CMD_UPDATE_PARAM_ALL, 0);
+        if (err != ERR_NONE)
+        {
+            ConfigIssue issue;
+            issue.entry.target = target;
+            issue.entry.item = "CMD_UPDATE_PARAM_ALL";
+            issue.error = err;
+            issues.push_back(issue);
+            if (result == ERR_NONE)
+            {
+                result = err;
+            }
+        }
+        return result;
+    }
+
+    int ConfigTransaction::applySingle(const ConfigEntry& entry, std::vector<ConfigIssue>& issues)
+    {
+        int err = DeWeSetParamStruct_str_s(entry.target, entry.item, entry.value);
+        if (err != ERR_NONE)
+        {
+            ConfigIssue issue;
+            issue.entry = entry;
+            issue.error = err;
+            issues.push_back(issue);
+        }
+        return err;
+    }
+
+} // trion
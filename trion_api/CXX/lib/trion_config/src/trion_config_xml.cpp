@@ -0,0 +1,151 @@
+// Copyright (c) DEWETRON GmbH 2026
+
+#include "trion_config_xml.h"
+#include <cctype>
+
+namespace
+{
+    const char* const VOLATILE_NAMES[] =
+    {
+        "SystemTime", "Temp*", "Teds*", "SensorOffset", "AmplifierOffset",
+        "ModeCheck", "SelfJustage", "ThreeWireInternalLineResistance", "Value",
+    };
+
+    bool matchesName(const std::string& name, const std::string& pattern)
+    {
+        if (!pattern.empty() && pattern.back() == '*')
+        {
+            return name.size() >= pattern.size() - 1 && name.compare(0, pattern.size() - 1, pattern, 0, pattern.size() - 1) == 0;
+        }
+        return name == pattern;
+    }
+
+} // namespace
+
+
+namespace trion
+{
+    bool equalsNoCase(const char* a, const char* b)
+    {
+        for (; *a && *b; ++a, ++b)
+        {
+            if (std::tolower(static_cast<unsigned char>(*a)) != std::tolower(static_cast<unsigned char>(*b)))
+            {
+                return false;
+            }
+        }
+        return *a == *b;
+    }
+
+    bool equalsNoCase(const std::string& a, const std::string& b)
+    {
+        return a.size() == b.size() && equalsNoCase(a.c_str(), b.c_str());
+    }
+
+    pugi::xml_node findChild(pugi::xml_node node, const char* name)
+    {
+        // exact match first, that is the common case
+        pugi::xml_node child = node.child(name);
+        if (child)
+        {
+            return child;
+        }
+        for (child = node.first_child(); child; child = child.next_sibling())
+        {
+            if (child.type() == pugi::node_element && equalsNoCase(child.name(), name))
+            {
+                return child;
+            }
+        }
+        return pugi::xml_node();
+    }
+
+    pugi::xml_attribute findAttribute(pugi::xml_node node, const char* name)
+    {
+        pugi::xml_attribute attribute = node.attribute(name);
+        if (attribute)
+        {
+            return attribute;
+        }
+        for (attribute = node.first_attribute(); attribute; attribute = attribute.next_attribute())
+        {
+            if (equalsNoCase(attribute.name(), name))
+            {
+                return attribute;
+            }
+        }
+        return pugi::xml_attribute();
+    }
+
+    pugi::xml_node walk(pugi::xml_node node, const std::string& path)
+    {
+        std::size_t pos = 0;
+        while (node && pos < path.size())
+        {
+            std::size_t next = path.find('/', pos);
+            if (next == std::string::npos)
+            {
+                next = path.size();
+            }
+            node = findChild(node, path.substr(pos, next - pos).c_str());
+            pos = next + 1;
+        }
+        return node;
+    }
+
+    bool isIdNode(pugi::xml_node node)
+    {
+        const char* name = node.name();
+        return node.type() == pugi::node_element
+            && name[0] == 'I' && name[1] == 'D'
+            && std::isdigit(static_cast<unsigned char>(name[2]));
+    }
+
+    std::string toLower(std::string text)
+    {
+        for (char& c : text)
+        {
+            c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        }
+        return text;
+    }
+
+    std::set<std::string> getVolatileNames()
+    {
+        std::set<std::string> names;
+        for (const char* name : VOLATILE_NAMES)
+        {
+            names.insert(toLower(name));
+        }
+        return names;
+    }
+
+    bool isVolatileQuery(const std::string& target, const std::string& command, const std::set<std::string>& names)
+    {
+        const std::string lower_command = toLower(command);
+        const std::string lower_target = toLower(target);
+        for (const std::string& pattern : names)
+        {
+            if (matchesName(lower_command, pattern))
+            {
+                return true;
+            }
+            std::size_t pos = 0;
+            while (pos <= lower_target.size())
+            {
+                std::size_t next = lower_target.find('/', pos);
+                if (next == std::string::npos)
+                {
+                    next = lower_target.size();
+                }
+                if (matchesName(lower_target.substr(pos, next - pos), pattern))
+                {
+                    return true;
+                }
+                pos = next + 1;
+            }
+        }
+        return false;
+    }
+
+} // trion
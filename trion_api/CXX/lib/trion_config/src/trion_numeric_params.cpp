@@ -0,0 +1,271 @@
+// Copyright (c) DEWETRON GmbH 2026
+
+#include "trion_numeric_params.h"
+#include "trion_config_transaction.h"
+#include "trion_config_xml.h"
+#include "dewepxi_apicxx.h"
+#include <pugixml.hpp>
+#include <cctype>
+#include <charconv>
+#include <cmath>
+
+namespace
+{
+    const char CONFIG_COMMAND[] = "config";
+
+    std::string_view trim(std::string_view text)
+    {
+        while (!text.empty() && std::isspace(static_cast<unsigned char>(text.front())))
+        {
+            text.remove_prefix(1);
+        }
+        while (!text.empty() && std::isspace(static_cast<unsigned char>(text.back())))
+        {
+            text.remove_suffix(1);
+        }
+        return text;
+    }
+
+    /**
+     * std::from_chars does not accept a leading '+'
+     */
+    std::string_view skipPlus(std::string_view text)
+    {
+        if (text.size() > 1 && text.front() == '+')
+        {
+            text.remove_prefix(1);
+        }
+        return text;
+    }
+
+} // namespace
+
+
+namespace trion
+{
+    bool parseNumber(std::string_view text, double& value)
+    {
+        text = skipPlus(trim(text));
+        if (text.empty())
+        {
+            return false;
+        }
+        const char* end = text.data() + text.size();
+        auto result = std::from_chars(text.data(), end, value);
+        return result.ec == std::errc() && result.ptr == end;
+    }
+
+    bool parseNumber(std::string_view text, int64_t& value)
+    {
+        text = skipPlus(trim(text));
+        if (text.empty())
+        {
+            return false;
+        }
+        const char* end = text.data() + text.size();
+        auto result = std::from_chars(text.data(), end, value);
+        if (result.ec == std::errc() && result.ptr == end)
+        {
+            return true;
+        }
+
+        double number;
+        if (!parseNumber(text, number) || std::trunc(number) != number
+            || number < -9223372036854775808.0 || number >= 9223372036854775808.0)
+        {
+            return false;
+        }
+        value = static_cast<int64_t>(number);
+        return true;
+    }
+
+    std::string formatNumber(double value)
+    {
+        char buffer[32];
+        auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+        return std::string(buffer, result.ptr);
+    }
+
+    std::string formatNumber(int64_t value)
+    {
+        char buffer[24];
+        auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+        return std::string(buffer, result.ptr);
+    }
+
+
+    NumericParams::NumericParams()
+        : m_volatile(getVolatileNames())
+        , m_volatile_entry()
+    {
+    }
+
+    int NumericParams::refresh(int board_no)
+    {
+        const std::string board = "BoardID" + std::to_string(board_no);
+        size_t length = 0;
+        int err = DeWeGetParamStruct_str_buf(board.c_str(), CONFIG_COMMAND, m_buffer, length);
+        if (err != ERR_NONE)
+        {
+            return err;
+        }
+
+        pugi::xml_document doc;
+        if (!doc.load_buffer(m_buffer.data(), length))
+        {
+            return ERR_INVALID_VALUE;
+        }
+
+        invalidate(board_no);
+
+        // (node, target) of the groups still to visit
+        std::vector<std::pair<pugi::xml_node, std::string>> groups;
+        pugi::xml_node root = doc.document_element();
+        groups.emplace_back(root.child("Acquisition").child("AcqProp"), board + "/AcqProp");
+        for (pugi::xml_node channel = root.child("Channel").first_child(); channel; channel = channel.next_sibling())
+        {
+            groups.emplace_back(channel, board + "/" + channel.name());
+        }
+
+        while (!groups.empty())
+        {
+            pugi::xml_node group = groups.back().first;
+            const std::string target = std::move(groups.back().second);
+            groups.pop_back();
+
+            for (pugi::xml_attribute attr = group.first_attribute(); attr; attr = attr.next_attribute())
+            {
+                store(target, attr.name(), attr.value());
+            }
+            for (pugi::xml_node node = group.first_child(); node; node = node.next_sibling())
+            {
+                if (node.type() != pugi::node_element)
+                {
+                    continue;
+                }
+                if (node.first_child().type() == pugi::node_element || node.first_attribute())
+                {
+                    groups.emplace_back(node, target + "/" + node.name());
+                }
+                if (!node.first_child() || node.first_child().type() == pugi::node_pcdata)
+                {
+                    store(target, node.name(), node.child_value());
+                }
+            }
+        }
+        return ERR_NONE;
+    }
+
+    void NumericParams::invalidate(int board_no)
+    {
+        for (auto it = m_values.begin(); it != m_values.end();)
+        {
+            int no;
+            std::string path;
+            if (parseBoardTarget(it->first.first, no, path) && no == board_no)
+            {
+                it = m_values.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+
+    void NumericParams::addVolatile(const std::string& name)
+    {
+        m_volatile.insert(toLower(name));
+    }
+
+    void NumericParams::clear()
+    {
+        m_values.clear();
+    }
+
+    std::size_t NumericParams::size() const
+    {
+        return m_values.size();
+    }
+
+    int NumericParams::getEntry(const std::string& target, const std::string& item, const Entry*& entry)
+    {
+        if (isVolatileQuery(target, item, m_volatile))
+        {
+            size_t length = 0;
+            int err = DeWeGetParamStruct_str_buf(target.c_str(), item.c_str(), m_buffer, length);
+            if (err != ERR_NONE)
+            {
+                return err;
+            }
+            if (!parseEntry(std::string_view(m_buffer.data(), length), m_volatile_entry))
+            {
+                return ERR_INVALID_VALUE;
+            }
+            entry = &m_volatile_entry;
+            return ERR_NONE;
+        }
+
+        const Key key(target, item);
+        auto it = m_values.find(key);
+        if (it == m_values.end())
+        {
+            size_t length = 0;
+            int err = DeWeGetParamStruct_str_buf(target.c_str(), item.c_str(), m_buffer, length);
+            if (err != ERR_NONE)
+            {
+                return err;
+            }
+            store(target, item, std::string_view(m_buffer.data(), length));
+            it = m_values.find(key);
+            if (it == m_values.end())
+            {
+                return ERR_INVALID_VALUE;
+            }
+        }
+        entry = &it->second;
+        return ERR_NONE;
+    }
+
+    int NumericParams::setText(const std::string& target, const std::string& item, const std::string& text)
+    {
+        int err = DeWeSetParamStruct_str_s(target, item, text);
+
+        // the board may adjust the value, and dependent values may change
+        int board_no;
+        std::string path;
+        if (parseBoardTarget(target, board_no, path))
+        {
+            invalidate(board_no);
+        }
+        else
+        {
+            m_values.erase(Key(target, item));
+        }
+        return err;
+    }
+
+    void NumericParams::store(const std::string& target, const std::string& item, std::string_view text)
+    {
+        Entry entry;
+        if (parseEntry(text, entry) && !isVolatileQuery(target, item, m_volatile))
+        {
+            m_values[Key(target, item)] = entry;
+        }
+    }
+
+    bool NumericParams::parseEntry(std::string_view text, Entry& entry)
+    {
+        entry = Entry();
+        if (!parseNumber(text, entry.number))
+        {
+            return false;
+        }
+        if (parseNumber(text, entry.integer))
+        {
+            entry.flags |= HAS_INTEGER;
+        }
+        return true;
+    }
+
+} // trion
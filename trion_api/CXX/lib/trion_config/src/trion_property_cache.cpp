@@ -0,0 +1,378 @@
+// Copyright (c) DEWETRON GmbH 2026
+
+#include "trion_property_cache.h"
+#include "trion_config_transaction.h"
+#include "trion_config_xml.h"
+#include "dewepxi_apicxx.h"
+#include <vector>
+
+namespace
+{
+    const int NO_BOARD = -1;
+    const char PROPERTIES_COMMAND[] = "BoardProperties";
+
+    /**
+     * Values that do not change while the board is open
+     */
+    const char* const CAPABILITY_COMMANDS[] =
+    {
+        "BoardProperties", "BoardName", "Channels"
+    };
+
+    bool isCapability(const std::string& command)
+    {
+        for (const char* c : CAPABILITY_COMMANDS)
+        {
+            if (trion::equalsNoCase(command.c_str(), c))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    int boardOf(const std::string& target, std::string& path)
+    {
+        int board_no;
+        if (trion::parseBoardTarget(target, board_no, path))
+        {
+            return board_no;
+        }
+        return NO_BOARD;
+    }
+
+    int getParamXmlString(const std::string& target, const std::string& command, std::string& value)
+    {
+        char buff[1024] = {0};
+        int err = DeWeGetParamXML_str(target.c_str(), command.c_str(), buff, sizeof(buff));
+        if (err == ERROR_BUFFER_TOO_SMALL)
+        {
+            uint32 buff_size = 0;
+            err = DeWeGetParamXML_strLEN(target.c_str(), command.c_str(), &buff_size);
+            if (err == ERR_NONE)
+            {
+                std::vector<char> heap_buff(buff_size + 1, 0);
+                err = DeWeGetParamXML_str(target.c_str(), command.c_str(), heap_buff.data(), static_cast<uint32>(heap_buff.size()));
+                if (err == ERR_NONE)
+                {
+                    value = heap_buff.data();
+                }
+            }
+        }
+        else if (err == ERR_NONE)
+        {
+            value = buff;
+        }
+        return err;
+    }
+
+} // namespace
+
+
+namespace trion
+{
+    PropertyCache::PropertyCache()
+        : m_volatile(getVolatileNames())
+        , m_stats()
+        , m_generation(0)
+    {
+    }
+
+    PropertyCache::~PropertyCache()
+    {
+    }
+
+    int PropertyCache::getParamStruct(const std::string& target, const std::string& command, std::string& value)
+    {
+        std::string path;
+        const int board_no = boardOf(target, path);
+        const Key key(target, command);
+        const bool capability = isCapability(command);
+        bool cacheable = false;
+        uint64_t generation = 0;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (isVolatileLocked(target, command))
+            {
+                ++m_stats.bypassed;
+            }
+            else
+            {
+                BoardCache& cache = m_boards[board_no];
+                auto& values = capability ? cache.capabilities : cache.values;
+                auto it = values.find(key);
+                if (it != values.end())
+                {
+                    ++m_stats.hits;
+                    value = it->second;
+                    return ERR_NONE;
+                }
+                ++m_stats.misses;
+                cacheable = true;
+                generation = m_generation;
+            }
+        }
+
+        // no lock during the API call, over TRIONET it is a network round trip
+        int err = DeWeGetParamStruct_str_s(target, command, value);
+        if (err == ERR_NONE && cacheable)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            // a set in between may have changed the value
+            if (generation == m_generation)
+            {
+                BoardCache& cache = m_boards[board_no];
+                (capability ? cache.capabilities : cache.values)[key] = value;
+            }
+        }
+        return err;
+    }
+
+    int PropertyCache::getParamXML(const std::string& target, const std::string& command, std::string& value)
+    {
+        std::string path;
+        const int board_no = boardOf(target, path);
+
+        const std::size_t prefix_len = sizeof(PROPERTIES_COMMAND) - 1;
+        if (board_no != NO_BOARD && equalsNoCase(path.substr(0, prefix_len), PROPERTIES_COMMAND)
+            && (path.size() == prefix_len || path[prefix_len] == '/'))
+        {
+            if (!isPrefetched(board_no))
+            {
+                prefetch(board_no);
+            }
+            std::lock_guard<std::mutex> lock(m_mutex);
+            BoardCache& cache = m_boards[board_no];
+            if (cache.properties)
+            {
+                const std::string sub_path = path.size() > prefix_len ? path.substr(prefix_len + 1) : std::string();
+                if (queryProperties(cache, sub_path, command, value))
+                {
+                    ++m_stats.local_queries;
+                    return ERR_NONE;
+                }
+            }
+        }
+
+        const Key key(target, command);
+        bool cacheable = false;
+        uint64_t generation = 0;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (isVolatileLocked(target, command))
+            {
+                ++m_stats.bypassed;
+            }
+            else
+            {
+                BoardCache& cache = m_boards[board_no];
+                auto it = cache.xml_values.find(key);
+                if (it != cache.xml_values.end())
+                {
+                    ++m_stats.hits;
+                    value = it->second;
+                    return ERR_NONE;
+                }
+                ++m_stats.misses;
+                cacheable = true;
+                generation = m_generation;
+            }
+        }
+
+        int err = getParamXmlString(target, command, value);
+        if (err == ERR_NONE && cacheable)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (generation == m_generation)
+            {
+                m_boards[board_no].xml_values[key] = value;
+            }
+        }
+        return err;
+    }
+
+    int PropertyCache::setParamStruct(const std::string& target, const std::string& command, const std::string& value)
+    {
+        std::string path;
+        const int board_no = boardOf(target, path);
+        invalidateTarget(board_no);
+        int err = DeWeSetParamStruct_str_s(target, command, value);
+        // again, a get during the call may have stored the old value
+        invalidateTarget(board_no);
+        return err;
+    }
+
+    int PropertyCache::setParam_i32(int board_no, int command, int value)
+    {
+        switch (command)
+        {
+        case CMD_START_ACQUISITION:
+        case CMD_STOP_ACQUISITION:
+            return DeWeSetParam_i32(board_no, command, value);
+        default:
+            break;
+        }
+
+        invalidateCommand(board_no, command);
+        int err = DeWeSetParam_i32(board_no, command, value);
+        invalidateCommand(board_no, command);
+        return err;
+    }
+
+    void PropertyCache::addVolatile(const std::string& name)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_volatile.insert(toLower(name));
+    }
+
+    bool PropertyCache::isVolatile(const std::string& target, const std::string& command) const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return isVolatileLocked(target, command);
+    }
+
+    int PropertyCache::prefetch(int board_no)
+    {
+        if (isPrefetched(board_no))
+        {
+            return ERR_NONE;
+        }
+        // the document is a capability, read from the API at most once
+        std::string properties_xml;
+        int err = getParamStruct("BoardID" + std::to_string(board_no), PROPERTIES_COMMAND, properties_xml);
+        if (err != ERR_NONE)
+        {
+            return err;
+        }
+
+        std::unique_ptr<pugi::xml_document> doc(new pugi::xml_document());
+        if (!doc->load_buffer(properties_xml.data(), properties_xml.size()))
+        {
+            return ERR_INVALID_VALUE;
+        }
+        std::lock_guard<std::mutex> lock(m_mutex);
+        BoardCache& cache = m_boards[board_no];
+        if (!cache.properties)
+        {
+            cache.properties = std::move(doc);
+        }
+        return ERR_NONE;
+    }
+
+    bool PropertyCache::isPrefetched(int board_no) const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_boards.find(board_no);
+        return it != m_boards.end() && it->second.properties;
+    }
+
+    void PropertyCache::invalidate(int board_no, bool keep_capabilities)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        invalidateLocked(board_no, keep_capabilities);
+    }
+
+    void PropertyCache::clear()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_boards.clear();
+        ++m_generation;
+    }
+
+    PropertyCache::Statistics PropertyCache::getStatistics() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_stats;
+    }
+
+    void PropertyCache::invalidateTarget(int board_no)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (board_no == NO_BOARD)
+        {
+            // eg network or API configuration, may affect any board
+            for (auto& board : m_boards)
+            {
+                invalidateLocked(board.first, true);
+            }
+            ++m_generation;
+        }
+        else
+        {
+            invalidateLocked(board_no, true);
+        }
+    }
+
+    void PropertyCache::invalidateCommand(int board_no, int command)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        switch (command)
+        {
+        case CMD_OPEN_BOARD:
+        case CMD_CLOSE_BOARD:
+        case CMD_RESET_BOARD:
+            invalidateLocked(board_no, false);
+            break;
+        case CMD_OPEN_BOARD_ALL:
+        case CMD_CLOSE_BOARD_ALL:
+        case CMD_RESET_BOARD_ALL:
+            m_boards.clear();
+            ++m_generation;
+            break;
+        default:
+            invalidateLocked(board_no, true);
+            break;
+        }
+    }
+
+    bool PropertyCache::isVolatileLocked(const std::string& target, const std::string& command) const
+    {
+        return isVolatileQuery(target, command, m_volatile);
+    }
+
+    bool PropertyCache::queryProperties(BoardCache& cache, const std::string& path, const std::string& command,
+        std::string& value)
+    {
+        pugi::xml_node context = walk(cache.properties->document_element(), path);
+        if (!context)
+        {
+            return false;
+        }
+
+        try
+        {
+            pugi::xpath_query query(command.c_str());
+            if (query.return_type() == pugi::xpath_type_node_set && !query.evaluate_node(context))
+            {
+                // let the API report the missing node
+                return false;
+            }
+            value = query.evaluate_string(context);
+            return true;
+        }
+        catch (const pugi::xpath_exception&)
+        {
+            return false;
+        }
+    }
+
+    void PropertyCache::invalidateLocked(int board_no, bool keep_capabilities)
+    {
+        auto it = m_boards.find(board_no);
+        ++m_generation;
+        if (it == m_boards.end())
+        {
+            return;
+        }
+        if (keep_capabilities)
+        {
+            it->second.values.clear();
+            it->second.xml_values.clear();
+        }
+        else
+        {
+            m_boards.erase(it);
+        }
+    }
+
+} // trion
@@ -0,0 +1,178 @@
+// Copyright (c) DEWETRON GmbH 2026
+
+#include "trion_property_validator.h"
+#include "trion_config_xml.h"
+#include "dewepxi_apicore.h"
+#include <cctype>
+#include <cstdio>
+
+namespace
+{
+    const char CHANNEL_GROUP_SUFFIX[] = "All";
+
+    std::string formatNumber(double value)
+    {
+        char text[32];
+        std::snprintf(text, sizeof(text), "%g", value);
+        return text;
+    }
+
+} // namespace
+
+
+namespace trion
+{
+    bool isChannelGroup(const std::string& name, std::string& prefix)
+    {
+        const std::size_t suffix_len = sizeof(CHANNEL_GROUP_SUFFIX) - 1;
+        if (name.size() <= suffix_len
+            || !equalsNoCase(name.c_str() + name.size() - suffix_len, CHANNEL_GROUP_SUFFIX)
+            || name.find('/') != std::string::npos)
+        {
+            return false;
+        }
+        prefix = name.substr(0, name.size() - suffix_len);
+        return true;
+    }
+
+    bool isChannelOfType(const char* channel_name, const std::string& prefix)
+    {
+        for (std::size_t n = 0; n < prefix.size(); ++n)
+        {
+            // also stops at the end of channel_name
+            if (std::tolower(static_cast<unsigned char>(channel_name[n])) != std::tolower(static_cast<unsigned char>(prefix[n])))
+            {
+                return false;
+            }
+        }
+        return std::isdigit(static_cast<unsigned char>(channel_name[prefix.size()])) != 0;
+    }
+
+
+    BoardPropertyValidator::BoardPropertyValidator()
+    {
+    }
+
+    bool BoardPropertyValidator::load(const std::string& properties_xml)
+    {
+        return m_caps.load(properties_xml);
+    }
+
+    bool BoardPropertyValidator::isLoaded() const
+    {
+        return m_caps.isLoaded();
+    }
+
+    const BoardCapabilities& BoardPropertyValidator::getCapabilities() const
+    {
+        return m_caps;
+    }
+
+    int BoardPropertyValidator::validate(const std::string& target, const std::string& item, const std::string& value,
+        const std::string& mode, std::string& message) const
+    {
+        if (!m_caps.isLoaded())
+        {
+            // nothing to validate against
+            return ERR_NONE;
+        }
+
+        std::string prefix;
+        if (isChannelGroup(target, prefix))
+        {
+            const std::vector<std::string> channels = m_caps.getChannels(prefix);
+            if (channels.empty())
+            {
+                message = target + ": no channels of this type";
+                return ERR_INVALID_CHANNEL_NO;
+            }
+            for (const std::string& channel : channels)
+            {
+                int err = validateChannel(channel, item, value, mode, message);
+                if (err != ERR_NONE)
+                {
+                    return err;
+                }
+            }
+            return ERR_NONE;
+        }
+
+        // acquisition groups like "AcqProp/SyncSettings" are channels without modes
+        if (!m_caps.hasChannel(target))
+        {
+            message = target + ": unknown target";
+            return ERR_INVALID_CHANNEL_NO;
+        }
+        return validateChannel(target, item, value, mode, message);
+    }
+
+    int BoardPropertyValidator::validateChannel(const std::string& channel, const std::string& item,
+        const std::string& value, const std::string& mode, std::string& message) const
+    {
+        if (equalsNoCase(item, "Mode") && m_caps.getModeCount(channel) > 0)
+        {
+            if (m_caps.hasMode(channel, value))
+            {
+                return ERR_NONE;
+            }
+            message = channel + ": mode " + value + " not supported";
+            return ERR_INVALID_VALUE;
+        }
+
+        // mode independent properties like "Used"
+        if (m_caps.hasProperty(channel, std::string(), item))
+        {
+            return validateProperty(channel, std::string(), item, value, message);
+        }
+
+        // properties of the requested mode, or of any mode if none is given
+        int result = ERR_PARAM_INVALID;
+        message = channel + "/" + item + ": unknown property";
+        for (std::size_t m = 0; m < m_caps.getModeCount(channel); ++m)
+        {
+            const std::string& mode_name = m_caps.getModeName(channel, m);
+            if ((!mode.empty() && !equalsNoCase(mode, mode_name)) || !m_caps.hasProperty(channel, mode_name, item))
+            {
+                continue;
+            }
+            std::string mode_message;
+            int err = validateProperty(channel, mode_name, item, value, mode_message);
+            if (err == ERR_NONE)
+            {
+                message.clear();
+                return ERR_NONE;
+            }
+            message = mode_message;
+            result = err;
+        }
+        return result;
+    }
+
+    int BoardPropertyValidator::validateProperty(const std::string& channel, const std::string& mode,
+        const std::string& item, const std::string& value, std::string& message) const
+    {
+        if (m_caps.isReadOnly(channel, mode, item))
+        {
+            message = channel + "/" + item + ": read-only property";
+            return ERR_PARAM_INVALID;
+        }
+        if (m_caps.isValidValue(channel, mode, item, value))
+        {
+            return ERR_NONE;
+        }
+
+        double min_value, max_value;
+        const bool programmable = m_caps.isProgrammable(channel, mode, item) || m_caps.getValueCount(channel, mode, item) == 0;
+        if (programmable && m_caps.getLimits(channel, mode, item, min_value, max_value))
+        {
+            message = item + ": " + value + " out of range [" + formatNumber(min_value) + ", "
+                + formatNumber(max_value) + "]";
+        }
+        else
+        {
+            message = item + ": " + value + " is not a supported value";
+        }
+        return ERR_INVALID_VALUE;
+    }
+
+} // trion
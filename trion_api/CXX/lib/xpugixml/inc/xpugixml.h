@@ -4,6 +4,9 @@
 #include "xpugixml_fwd.h"
 #include <pugixml.hpp>
 #include <string>
+#ifdef USE_CXX17
+#include <string_view>
+#endif
 
 /**
  * Dewetron extensions for pugixml.
@@ -97,6 +100,24 @@ namespace xpugi
      */
     std::string getRawText(pugi::xpath_node xnode);
 
+#ifdef USE_CXX17
+    /**
+     * getText without copy.
+     * A node with a single text child, the common case for property values,
+     * is returned as view into the document. Otherwise the text is concatenated
+     * into buffer, whose capacity is reused, and the view refers to buffer.
+     * @return the whitespace trimmed text, valid until the document or buffer changes
+     */
+    std::string_view getTextView(pugi::xml_node node, std::string& buffer);
+    std::string_view getTextView(pugi::xml_attribute attr);
+
+    /**
+     * getRawText without copy, see getTextView.
+     * @return the text, not whitespace trimmed
+     */
+    std::string_view getRawTextView(pugi::xml_node node, std::string& buffer);
+#endif
+
     /**
      * DOM3 getTextFromNode
      * On getting, no serialization is performed, the returned string does not contain any markup.
@@ -211,6 +232,29 @@ namespace xpugi
       */
     std::string toXML(pugi::xpath_node xnode, bool pretty = false);
 
+    /**
+     * Serialize into a caller provided string, its capacity is reused.
+     * Use these when documents are serialized repeatedly.
+     * @param xml receives the xml representation
+     */
+    void toXML(const pugi::xml_document& doc, std::string& xml, bool pretty = false);
+    void toXML(pugi::xml_node node, std::string& xml, bool pretty = false);
+
+    /**
+     * pugi::xml_writer appending to a string.
+     * Avoids the stream overhead of pugi::xml_writer_stream.
+     */
+    class xml_string_writer : public pugi::xml_writer
+    {
+    public:
+        explicit xml_string_writer(std::string& buffer);
+
+        void write(const void* data, size_t size) override;
+
+    private:
+        std::string& m_buffer;
+    };
+
     /**
      * Parses a xml text and returns the pretty printed document.
      */
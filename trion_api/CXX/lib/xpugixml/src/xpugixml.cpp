@@ -3,22 +3,74 @@
 #include "xpugixml.h"
 #include "uni_assert.h"
 #include <fstream>
-#include <sstream>
 #include <vector>
 
 namespace 
 {
-    std::string trim(const std::string& str)
+    void trim(std::string& str)
     {
         size_t first = str.find_first_not_of(' ');
         if (std::string::npos == first)
+        {
+            return;
+        }
+        size_t last = str.find_last_not_of(' ');
+        str.erase(last + 1);
+        str.erase(0, first);
+    }
+
+#ifdef USE_CXX17
+    std::string_view trim(std::string_view str)
+    {
+        size_t first = str.find_first_not_of(' ');
+        if (std::string_view::npos == first)
         {
             return str;
         }
         size_t last = str.find_last_not_of(' ');
         return str.substr(first, (last - first + 1));
     }
-    
+#endif
+
+    /**
+     * Text of a node that is, or has exactly one, text node.
+     * @return the text or nullptr if it has to be concatenated by getTextImpl
+     */
+    const char* getSingleText(pugi::xml_node node)
+    {
+        switch (node.type())
+        {
+        case pugi::node_element:
+        {
+            pugi::xml_node child = node.first_child();
+            if (!child)
+            {
+                return "";
+            }
+            if (child.next_sibling())
+            {
+                return nullptr;
+            }
+            switch (child.type())
+            {
+            case pugi::node_cdata:
+            case pugi::node_pcdata:
+                return child.value();
+            case pugi::node_element:
+                return nullptr;
+            default:
+                return "";
+            }
+        }
+
+        case pugi::node_cdata:
+        case pugi::node_pcdata:
+            return node.value();
+        default:
+            return "";
+        }
+    }
+
 } // namespace 
 
 
@@ -134,10 +186,18 @@ namespace xpugi
     {
         std::string text;
 
-        priv::getTextImpl(node, text);
+        const char* single = getSingleText(node);
+        if (single)
+        {
+            text = single;
+        }
+        else
+        {
+            priv::getTextImpl(node, text);
+        }
 
         // trim whitespace and return
-        text = trim(text);
+        trim(text);
         return text;
     }
 
@@ -145,7 +205,7 @@ namespace xpugi
     {
         std::string text = attr.value();
         // trim whitespace and return
-        text = trim(text);
+        trim(text);
         return text;
     }
 
@@ -166,6 +226,11 @@ namespace xpugi
 
     std::string getRawText(pugi::xml_node node)
     {
+        const char* single = getSingleText(node);
+        if (single)
+        {
+            return single;
+        }
         std::string text;
         priv::getTextImpl(node, text);
         return text;
@@ -192,6 +257,30 @@ namespace xpugi
         return "";
     }
 
+#ifdef USE_CXX17
+    std::string_view getTextView(pugi::xml_node node, std::string& buffer)
+    {
+        return trim(getRawTextView(node, buffer));
+    }
+
+    std::string_view getTextView(pugi::xml_attribute attr)
+    {
+        return trim(std::string_view(attr.value()));
+    }
+
+    std::string_view getRawTextView(pugi::xml_node node, std::string& buffer)
+    {
+        const char* single = getSingleText(node);
+        if (single)
+        {
+            return single;
+        }
+        buffer.clear();
+        priv::getTextImpl(node, buffer);
+        return buffer;
+    }
+#endif
+
     std::string getTextFromNode(pugi::xml_node node)
     {
         std::string text;
@@ -225,7 +314,7 @@ namespace xpugi
         }
 
         // trim whitespace and return
-        text = trim(text);
+        trim(text);
         return text;
     }
 
@@ -352,12 +441,13 @@ namespace xpugi
 
     std::string getInnerXML(pugi::xml_node node)
     {
-        std::ostringstream s;
+        std::string xml;
+        xml_string_writer writer(xml);
         for (auto& c : node.children())
         {
-            c.print(s, "", pugi::format_raw);
+            c.print(writer, "", pugi::format_raw);
         }
-        return s.str();
+        return xml;
     }
 
     std::string toXML(pugi::xml_document_ptr doc, bool pretty)
@@ -367,43 +457,65 @@ namespace xpugi
 
     std::string toXML(pugi::xml_document& doc, bool pretty)
     {
-        std::stringstream ss;
+        std::string xml;
+        toXML(doc, xml, pretty);
+        return xml;
+    }
+
+
+    std::string toXML(pugi::xml_node node, bool pretty)
+    {
+        std::string xml;
+        toXML(node, xml, pretty);
+        return xml;
+    }
+
+    std::string toXML(pugi::xpath_node xnode, bool pretty)
+    {
+        pugi::xml_node node = xnode.node();
+        if (node)
+        {
+            return toXML(node, pretty);
+        }
+        return "";
+    }
+
+    void toXML(const pugi::xml_document& doc, std::string& xml, bool pretty)
+    {
+        xml.clear();
+        xml_string_writer writer(xml);
         if (pretty)
         {
-            doc.save(ss);
+            doc.save(writer);
         }
         else
         {
-            doc.save(ss, "", pugi::format_raw);
+            doc.save(writer, "", pugi::format_raw);
         }
-
-        return ss.str();
     }
 
-
-    std::string toXML(pugi::xml_node node, bool pretty)
+    void toXML(pugi::xml_node node, std::string& xml, bool pretty)
     {
-        std::stringstream ss;
+        xml.clear();
+        xml_string_writer writer(xml);
         if (pretty)
         {
-            node.print(ss);
+            node.print(writer);
         }
         else
         {
-            node.print(ss, "", pugi::format_raw);
+            node.print(writer, "", pugi::format_raw);
         }
+    }
 
-        return ss.str();
+    xml_string_writer::xml_string_writer(std::string& buffer)
+        : m_buffer(buffer)
+    {
     }
 
-    std::string toXML(pugi::xpath_node xnode, bool pretty)
+    void xml_string_writer::write(const void* data, size_t size)
     {
-        pugi::xml_node node = xnode.node();
-        if (node)
-        {
-            return toXML(node, pretty);
-        }
-        return "";
+        m_buffer.append(static_cast<const char*>(data), size);
     }
 
     std::string xmlPrettyPrint(const std::string& xml_txt)
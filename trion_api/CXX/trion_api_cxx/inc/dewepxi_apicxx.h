@@ -1,10 +1,17 @@
 // Copyright DEWETRON 2019
+#pragma once
 
 #include <string>
+#include <vector>
 #include "dewepxi_apicore.h"
 #include "dewepxi_apiutil.h"
 #include "dewepxi_types.h"
 
+#if __cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L)
+#include <string_view>
+#define DEWEPXI_APICXX_STRING_VIEW
+#endif
+
 
 /**
  * DeWeSetParamStruct_str overload for std::string
@@ -14,5 +21,31 @@ int DeWeSetParamStruct_str_s(const std::string& target, const std::string& item,
 
 /**
  * DeWeGetParamStruct_str overload for std::string
+ * The capacity of value is reused, no allocation once it is large enough.
+ */
+int DeWeGetParamStruct_str_s(const std::string& target, const std::string& item, std::string& value);
+
+
+/**
+ * DeWeGetParamStruct_str into a caller provided, growable buffer.
+ *
+ * The buffer is only grown, never shrunk. DeWeGetParamStruct_strLEN is
+ * queried only if the buffer is too small. The largest size needed per
+ * (target, item) is remembered per thread, so large values like
+ * "BoardProperties" or "ScanDescriptor_V3" are read with one call
+ * after the first time.
+ *
+ * @param buffer receives the zero terminated value
+ * @param length receives the length of the value without terminator
+ */
+int DeWeGetParamStruct_str_buf(const char* target, const char* item, std::vector<char>& buffer, size_t& length);
+
+
+#ifdef DEWEPXI_APICXX_STRING_VIEW
+/**
+ * DeWeGetParamStruct_str into a thread local buffer.
+ * The returned view is valid until the next DeWeGetParamStruct_str_sv
+ * or DeWeGetParamStruct_str_s call of the same thread.
  */
-int DeWeGetParamStruct_str_s(const std::string& target, const std::string& item, std::string& value);
\ No newline at end of file
+int DeWeGetParamStruct_str_sv(const char* target, const char* item, std::string_view& value);
+#endif
@@ -0,0 +1,46 @@
+// Copyright (c) DEWETRON GmbH 2026
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+/**
+ * 64 bit FNV-1a, the one hash used for property cache keys
+ * (DeWeGetParamStruct_str_buf, trion::ParamPath) and TEDS fingerprints.
+ * C++11, so it can be used by all modules.
+ */
+namespace trion
+{
+    constexpr uint64_t FNV_OFFSET_BASIS = 14695981039346656037ULL;
+    constexpr uint64_t FNV_PRIME = 1099511628211ULL;
+
+    /**
+     * Separator between target and item of a property key.
+     */
+    constexpr unsigned char FNV_PARAM_SEPARATOR = '\n';
+
+    constexpr uint64_t fnv1aStep(uint64_t hash, unsigned char c)
+    {
+        return (hash ^ c) * FNV_PRIME;
+    }
+
+    inline uint64_t fnv1a(const char* data, std::size_t length, uint64_t hash = FNV_OFFSET_BASIS)
+    {
+        for (std::size_t n = 0; n < length; ++n)
+        {
+            hash = fnv1aStep(hash, static_cast<unsigned char>(data[n]));
+        }
+        return hash;
+    }
+
+    /**
+     * Key of (target, item), eg for a property cache.
+     */
+    inline uint64_t fnv1aParamKey(const char* target, const char* item)
+    {
+        const uint64_t hash = fnv1aStep(fnv1a(target, std::strlen(target)), FNV_PARAM_SEPARATOR);
+        return fnv1a(item, std::strlen(item), hash);
+    }
+
+} // trion
@@ -0,0 +1,265 @@
+// Copyright (c) DEWETRON GmbH 2026
+#pragma once
+
+#include "dewepxi_hash.h"
+
+// needs std::string_view and C++17 constexpr
+#if __cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L)
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+/**
+ * Target path builder for the DeWe*ParamStruct_str functions.
+ *
+ * Builds targets like "BoardID0/AI3" in a small inline buffer,
+ * without snprintf, streams or heap allocation, and at compile time
+ * if the arguments are constant:
+ *
+ * @code
+ * constexpr auto range = trion::Board(0).ai(3).prop("Range");
+ * DeWeSetParamStruct_str(range.target.c_str(), range.item, "10 V");
+ *
+ * for (unsigned board = 0; board < num_boards; ++board)
+ * {
+ *     auto acq = trion::Board(board).acqProp();
+ *     DeWeSetParamStruct_str(acq.c_str(), "SampleRate", "2000");
+ * }
+ * @endcode
+ */
+namespace trion
+{
+    enum class ChannelType
+    {
+        AI,
+        CNT,
+        BoardCNT,
+        Discret,
+        CAN,
+        UART,
+        ARef,
+        AO,
+    };
+
+    /**
+     * Channel names as used in targets. Only defined for known channel
+     * types, so a wrong type does not compile.
+     */
+    template <ChannelType T> struct ChannelTraits;
+    template <> struct ChannelTraits<ChannelType::AI>       { static constexpr const char* name = "AI"; };
+    template <> struct ChannelTraits<ChannelType::CNT>      { static constexpr const char* name = "CNT"; };
+    template <> struct ChannelTraits<ChannelType::BoardCNT> { static constexpr const char* name = "BoardCNT"; };
+    template <> struct ChannelTraits<ChannelType::Discret>  { static constexpr const char* name = "Discret"; };
+    template <> struct ChannelTraits<ChannelType::CAN>      { static constexpr const char* name = "CAN"; };
+    template <> struct ChannelTraits<ChannelType::UART>     { static constexpr const char* name = "UART"; };
+    template <> struct ChannelTraits<ChannelType::ARef>     { static constexpr const char* name = "ARef"; };
+    template <> struct ChannelTraits<ChannelType::AO>       { static constexpr const char* name = "AO"; };
+
+    constexpr uint64_t fnv1a(std::string_view text, uint64_t hash = FNV_OFFSET_BASIS)
+    {
+        for (char c : text)
+        {
+            hash = fnv1aStep(hash, static_cast<unsigned char>(c));
+        }
+        return hash;
+    }
+
+    struct ParamPath;
+
+    /**
+     * A target path in an inline buffer.
+     * Text exceeding the capacity is dropped and valid() returns false.
+     */
+    class TargetPath
+    {
+    public:
+        static constexpr std::size_t CAPACITY = 63;
+
+        constexpr TargetPath()
+            : m_text{}
+            , m_size(0)
+            , m_overflow(false)
+        {
+        }
+
+        constexpr explicit TargetPath(std::string_view text)
+            : TargetPath()
+        {
+            append(text);
+        }
+
+        constexpr TargetPath& append(std::string_view text)
+        {
+            for (char c : text)
+            {
+                if (m_size == CAPACITY)
+                {
+                    m_overflow = true;
+                    break;
+                }
+                m_text[m_size++] = c;
+            }
+            return *this;
+        }
+
+        constexpr TargetPath& appendNumber(unsigned int value)
+        {
+            char digits[10] = {};
+            std::size_t count = 0;
+            do
+            {
+                digits[count++] = static_cast<char>('0' + value % 10);
+                value /= 10;
+            } while (value != 0);
+            while (count > 0)
+            {
+                const char digit[1] = { digits[--count] };
+                append(std::string_view(digit, 1));
+            }
+            return *this;
+        }
+
+        /**
+         * Append a path segment, eg acqProp() / "SyncSettings" / "SyncIn"
+         */
+        constexpr TargetPath operator/(std::string_view segment) const
+        {
+            TargetPath path(*this);
+            path.append("/").append(segment);
+            return path;
+        }
+
+        constexpr ParamPath prop(const char* item) const;
+
+        constexpr const char* c_str() const
+        {
+            return m_text;
+        }
+
+        constexpr std::size_t size() const
+        {
+            return m_size;
+        }
+
+        constexpr bool valid() const
+        {
+            return !m_overflow;
+        }
+
+        constexpr std::string_view view() const
+        {
+            return std::string_view(m_text, m_size);
+        }
+
+        constexpr uint64_t hash() const
+        {
+            return fnv1a(view());
+        }
+
+        constexpr bool operator==(const TargetPath& other) const
+        {
+            return view() == other.view();
+        }
+
+    private:
+        char m_text[CAPACITY + 1];
+        std::size_t m_size;
+        bool m_overflow;
+    };
+
+    /**
+     * Target and item of one property.
+     */
+    struct ParamPath
+    {
+        TargetPath target;
+        const char* item;
+
+        /**
+         * Hash of (target, item), usable as cache key.
+         * Matches the key used by DeWeGetParamStruct_str_buf.
+         */
+        constexpr uint64_t hash() const
+        {
+            return fnv1a(std::string_view(item), fnv1aStep(target.hash(), FNV_PARAM_SEPARATOR));
+        }
+    };
+
+    constexpr ParamPath TargetPath::prop(const char* item) const
+    {
+        return ParamPath{ *this, item };
+    }
+
+    /**
+     * Targets of one board.
+     */
+    class Board
+    {
+    public:
+        constexpr explicit Board(unsigned int board_no)
+            : m_target("BoardID")
+        {
+            m_target.appendNumber(board_no);
+        }
+
+        constexpr const TargetPath& target() const
+        {
+            return m_target;
+        }
+
+        /**
+         * Board level property, eg "BoardName"
+         */
+        constexpr ParamPath prop(const char* item) const
+        {
+            return m_target.prop(item);
+        }
+
+        constexpr TargetPath acqProp() const
+        {
+            return m_target / "AcqProp";
+        }
+
+        /**
+         * Single channel, eg "BoardID0/AI3"
+         */
+        template <ChannelType T>
+        constexpr TargetPath channel(unsigned int index) const
+        {
+            TargetPath path = m_target / ChannelTraits<T>::name;
+            path.appendNumber(index);
+            return path;
+        }
+
+        /**
+         * All channels of a type, eg "BoardID0/AIAll"
+         */
+        template <ChannelType T>
+        constexpr TargetPath all() const
+        {
+            TargetPath path = m_target / ChannelTraits<T>::name;
+            path.append("All");
+            return path;
+        }
+
+        constexpr TargetPath ai(unsigned int index) const { return channel<ChannelType::AI>(index); }
+        constexpr TargetPath aiAll() const { return all<ChannelType::AI>(); }
+        constexpr TargetPath cnt(unsigned int index) const { return channel<ChannelType::CNT>(index); }
+        constexpr TargetPath cntAll() const { return all<ChannelType::CNT>(); }
+        constexpr TargetPath boardCnt(unsigned int index) const { return channel<ChannelType::BoardCNT>(index); }
+        constexpr TargetPath boardCntAll() const { return all<ChannelType::BoardCNT>(); }
+        constexpr TargetPath di(unsigned int index) const { return channel<ChannelType::Discret>(index); }
+        constexpr TargetPath diAll() const { return all<ChannelType::Discret>(); }
+        constexpr TargetPath can(unsigned int index) const { return channel<ChannelType::CAN>(index); }
+        constexpr TargetPath canAll() const { return all<ChannelType::CAN>(); }
+        constexpr TargetPath uart(unsigned int index) const { return channel<ChannelType::UART>(index); }
+        constexpr TargetPath uartAll() const { return all<ChannelType::UART>(); }
+
+    private:
+        TargetPath m_target;
+    };
+
+} // trion
+
+#endif // C++17
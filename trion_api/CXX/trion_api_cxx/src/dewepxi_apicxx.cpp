@@ -2,7 +2,31 @@
 
 #include "dewepxi_apicxx.h"
 #include "dewepxi_apicore.h"
+#include "dewepxi_hash.h"
 #include <inttypes.h>
+#include <cstring>
+#include <unordered_map>
+
+namespace
+{
+    const size_t DEFAULT_BUFFER_SIZE = 1024;  // 1 page
+
+    /**
+     * Largest buffer size needed per (target, item)
+     */
+    std::unordered_map<uint64_t, size_t>& highWaterSizes()
+    {
+        thread_local std::unordered_map<uint64_t, size_t> sizes;
+        return sizes;
+    }
+
+    std::vector<char>& threadBuffer()
+    {
+        thread_local std::vector<char> buffer;
+        return buffer;
+    }
+}
+
 
 int DeWeSetParamStruct_str_s(const std::string& target, const std::string& item, const std::string& value )
 {
@@ -12,27 +36,68 @@ int DeWeSetParamStruct_str_s(const std::string& target, const std::string& item,
 
 int DeWeGetParamStruct_str_s(const std::string& target, const std::string& item, std::string& value)
 {
-    char buff[1024] = {0};  // 1 page
-    auto err = DeWeGetParamStruct_str(target.c_str(), item.c_str(), buff, sizeof(buff));
+    std::vector<char>& buffer = threadBuffer();
+    size_t length = 0;
+    auto err = DeWeGetParamStruct_str_buf(target.c_str(), item.c_str(), buffer, length);
+    if (err == ERR_NONE)
+    {
+        value.assign(buffer.data(), length);
+    }
+    return err;
+}
+
+
+int DeWeGetParamStruct_str_buf(const char* target, const char* item, std::vector<char>& buffer, size_t& length)
+{
+    length = 0;
+    const uint64_t key = trion::fnv1aParamKey(target, item);
+    auto& sizes = highWaterSizes();
+
+    size_t buff_size = DEFAULT_BUFFER_SIZE;
+    auto it = sizes.find(key);
+    if (it != sizes.end() && it->second > buff_size)
+    {
+        buff_size = it->second;
+    }
+    if (buffer.size() < buff_size)
+    {
+        buffer.resize(buff_size);
+    }
+
+    auto err = DeWeGetParamStruct_str(target, item, buffer.data(), static_cast<uint32>(buffer.size()));
     if (err == ERROR_BUFFER_TOO_SMALL)
     {
-        uint32_t buff_size;
-        err = DeWeGetParamStruct_strLEN(target.c_str(), item.c_str(), &buff_size);
+        uint32 needed = 0;
+        err = DeWeGetParamStruct_strLEN(target, item, &needed);
         if (err == ERR_NONE)
         {
-            auto heap_buff = new char(buff_size);
-            err = DeWeGetParamStruct_str(target.c_str(), item.c_str(), heap_buff, buff_size);
-            if (err == ERR_NONE)
+            // room for the terminator, whether included by the API or not
+            buff_size = static_cast<size_t>(needed) + 1;
+            if (buffer.size() < buff_size)
             {
-                value = std::string(heap_buff, buff_size);
+                buffer.resize(buff_size);
             }
-            delete [] heap_buff;
+            sizes[key] = buff_size;
+            err = DeWeGetParamStruct_str(target, item, buffer.data(), static_cast<uint32>(buffer.size()));
         }
     }
-    else
+
+    if (err == ERR_NONE)
     {
-        value = std::string(buff);
+        buffer.back() = 0;
+        length = strlen(buffer.data());
     }
+    return err;
+}
 
+
+#ifdef DEWEPXI_APICXX_STRING_VIEW
+int DeWeGetParamStruct_str_sv(const char* target, const char* item, std::string_view& value)
+{
+    std::vector<char>& buffer = threadBuffer();
+    size_t length = 0;
+    auto err = DeWeGetParamStruct_str_buf(target, item, buffer, length);
+    value = (err == ERR_NONE) ? std::string_view(buffer.data(), length) : std::string_view();
     return err;
-}
\ No newline at end of file
+}
+#endif
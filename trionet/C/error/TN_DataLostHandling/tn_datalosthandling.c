@@ -56,7 +56,7 @@ int main(int argc, char* argv[])
     char sGetResultString[256]={0};
     char sformatString[256] = {0};
     char sErrorText[256]  = {0};
-    float fSampleRate = 0.0f;
+    double fSampleRate = 0.0;
     int nBlockSize=0;
     uint32 uLastSampleCount = 0;
     int nBdCNTOffset = 0;
@@ -199,7 +199,7 @@ int main(int argc, char* argv[])
     CheckError(nErrorCode);
     nErrorCode = DeWeGetParamStruct_str( sChannelStr, "SampleRate", sGetResultString, sizeof(sGetResultString));
     CheckError(nErrorCode);
-    sscanf(sGetResultString, "%f", &fSampleRate);
+    sscanf(sGetResultString, "%lf", &fSampleRate);
     nBlockSize = (int)((fSampleRate * nPollIntervall) / 1000);
 
 
@@ -1,10 +1,10 @@
 // Copyright (c) Dewetron 2019
 
 #include "dewepxi_apicxx.h"
+#include "dewepxi_target.h"
 #include "trion_sdk_util.h"
 #include "xpugixml.h"
 #include <string>
-#include <sstream>
 #include <iostream>
 
 
@@ -48,25 +48,21 @@ int main(int argc, char* argv[])
     // Configure Acquisition properties - standalone for every board
     for (int nBoardId = 0; nBoardId < nNoOfBoards; ++nBoardId)
     {
-        std::stringstream sTarget;
-        sTarget << "BoardID" << nBoardId << "/AcqProp";
-        std::string target = sTarget.str();
-        nErrorCode = DeWeSetParamStruct_str_s( target, "OperationMode", "Slave");
+        const auto target = trion::Board(nBoardId).acqProp();
+        nErrorCode = DeWeSetParamStruct_str( target.c_str(), "OperationMode", "Slave");
         CheckError(nErrorCode);
-        nErrorCode = DeWeSetParamStruct_str_s( target, "ExtTrigger", "False");
+        nErrorCode = DeWeSetParamStruct_str( target.c_str(), "ExtTrigger", "False");
         CheckError(nErrorCode);
-        nErrorCode = DeWeSetParamStruct_str_s( target, "ExtClk", "False");
+        nErrorCode = DeWeSetParamStruct_str( target.c_str(), "ExtClk", "False");
         CheckError(nErrorCode);
-        nErrorCode = DeWeSetParamStruct_str_s( target, "SampleRate", "200000");
+        nErrorCode = DeWeSetParamStruct_str( target.c_str(), "SampleRate", "200000");
     }
 
     // Enable analog channels on all boards
     for (int nBoardId = 0; nBoardId < nNoOfBoards; ++nBoardId)
     {
-        std::stringstream sTarget;
-        sTarget << "BoardID" << nBoardId << "/AIAll";
-        std::string target = sTarget.str();
-        nErrorCode = DeWeSetParamStruct_str_s( target, "Used", "True");
+        const auto target = trion::Board(nBoardId).aiAll();
+        nErrorCode = DeWeSetParamStruct_str( target.c_str(), "Used", "True");
         CheckError(nErrorCode);
     }
 